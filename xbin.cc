@@ -2,6 +2,30 @@
 
 #include "xlib_test.h"
 
+namespace xbin_test {
+
+struct Head {
+  uint32_t id;
+  int16_t  code;
+};
+XBIN_FIELDS(Head, id, code)
+
+struct Msg {
+  Head                    head;
+  uint8_t                 flag;
+  std::array<uint16_t, 3> vals;
+  uint64_t                stamp;
+};
+XBIN_FIELDS(Msg, head, flag, vals, stamp)
+
+struct Var {
+  uint16_t    id;
+  xlib::gbin  body;
+};
+XBIN_FIELDS(Var, id, body)
+
+}  // namespace xbin_test
+
 SHOW_TEST_INIT(xbin)
 
 xlib::lbin lb, aa;
@@ -100,6 +124,38 @@ done = lb.size() == sizeof(uint16_t) + 6 && *(const uint16_t*)lb.data() == 0x000
        vb.size() == 7 && *(const uint8_t*)vb.data() == 0x06;
 SHOW_TEST_RESULT;
 
+SHOW_TEST_HEAD(<< open_head);
+lb.clear(); gb.clear(); vb.clear();
+aa.clear(); bb.clear(); cc.clear();
+{
+  const auto la = lb.open_head();
+  const auto ga = gb.open_head();
+  const auto va = vb.open_head();
+  lb << "12";
+  gb << "12";
+  vb << "12";
+  const auto lc = lb.open_head();
+  const auto gc = gb.open_head();
+  const auto vc = vb.open_head();
+  lb << "3456";
+  gb << "3456";
+  vb << "3456";
+  lb.close_head(lc).close_head(la);
+  gb.close_head(gc).close_head(ga);
+  vb.close_head(vc).close_head(va);
+}
+aa << "3456"; aa = (xlib::lbin() << "12" << aa).mkhead();
+bb << "3456"; bb = (xlib::gbin() << "12" << bb).mkhead();
+done = lb == aa && gb == bb && vb.size() == 2 * vb.head_size() + 6;
+lb >> aa; aa.erase(0, 2); aa >> aa;
+gb >> bb; bb.erase(0, 3); bb >> bb;
+vb >> cc; cc.erase(0, 2); cc >> cc;
+done = done && lb.empty() && gb.empty() && vb.empty() &&
+       0 == memcmp(aa.data(), "3456", 4) && aa.size() == 4 &&
+       0 == memcmp(bb.data(), "3456", 5) && bb.size() == 5 &&
+       0 == memcmp(cc.data(), "3456", 4) && cc.size() == 4;
+SHOW_TEST_RESULT;
+
 SHOW_TEST_HEAD(>> void*);
 lb.clear(); gb.clear(); vb.clear();
 lb << (void*)0x12345678 << true  << (uint8_t)0x11  << (int8_t)0x11  << "123456" << '\0';
@@ -195,4 +251,331 @@ vb << L'\0' >> L'\0';
 done = lb.empty() && gb.empty() && vb.empty();
 SHOW_TEST_RESULT;
 
+SHOW_TEST_HEAD(xbin_reader);
+lb.clear(); gb.clear(); vb.clear();
+aa.clear(); bb.clear(); cc.clear();
+aa << "abc"; bb << "abc"; cc << "abc";
+lb << (void*)0x12345678 << true  << (uint32_t)0x11 << (int8_t)-2 << "123456" << '\0' << aa << "xy";
+gb << (void*)0x12345678 << false << (uint32_t)0x11 << (int8_t)-2 << "123456" << bb << "xy";
+vb << (void*)0x12345678 << true  << (uint32_t)0x11 << (int8_t)-2 << "123456" << '\0' << cc << "xy";
+{
+  xlib::xbin_reader lr(lb);
+  xlib::xbin_reader gr(gb);
+  xlib::xbin_reader vr(vb);
+  void* p[3];
+  bool b[3];
+  uint32_t u[3];
+  int8_t i[3];
+  char str[3][0x10];
+  std::string xy[3];
+  lr >> p[0] >> b[0] >> u[0] >> i[0] >> (char*)str[0] >> '\0' >> aa >> xy[0];
+  gr >> p[1] >> b[1] >> u[1] >> i[1] >> (char*)str[1] >> bb >> xy[1];
+  vr >> p[2] >> b[2] >> u[2] >> i[2] >> (char*)str[2] >> '\0' >> cc >> xy[2];
+  done = true;
+  for (int k = 0; k < 3; ++k) {
+    done = done && p[k] == (void*)0x12345678 && b[k] == (k != 1) &&
+           u[k] == 0x11 && i[k] == -2 && 0 == memcmp(str[k], "123456", 6) &&
+           0 == strcmp(xy[k].c_str(), "xy");
+  }
+  done = done && lr.empty() && gr.empty() && vr.empty() &&
+         aa.size() == 3 && bb.size() == 4 && cc.size() == 3 &&
+         lb.size() == lr.pos() && !lb.empty();
+  lr.rewind(2);
+  done = done && lr.remain() == 2;
+  lr.rewind();
+  done = done && lr.remain() == lb.size();
+  lr.skip(lb.size() - 1);
+  try {
+    lr >> u[0];
+    done = false;
+  } catch (...) {
+    done = done && lr.remain() == 1;
+  }
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xbin_view);
+{
+  // 模拟外部缓冲。
+  const uint8_t buf[] = {0x00, 0x05, 'h', 'e', 'l', 'l', 'o', 0x12, 0x34, 0x56};
+  xlib::gbin_view gv(buf, sizeof(buf));
+  xlib::gbin_view sub;
+  uint16_t w = 0;
+  gv >> sub >> w;
+  std::string hello;
+  sub >> hello;
+  done = hello == "hello" && w == 0x1234 && gv.remain() == 1 &&
+         sub.empty() && sub.pos() == 5;
+
+  const std::basic_string_view<uint8_t> vbuf(buf + 1, 6);
+  xlib::vbin_view vv(vbuf);
+  vv >> vv;
+  done = done && vv.remain() == 5 && *vv.data() == 'h';
+#ifdef __cpp_lib_span
+  xlib::lbin_view lv(std::span<const uint8_t>(buf + 7, 3));
+  lv >> w;
+  done = done && w == 0x3412 && lv.remain() == 1;
+#endif
+  try {
+    gv >> w;
+    done = false;
+  } catch (...) {
+    done = done && gv.remain() == 1;
+  }
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(<< >> T[]);
+{
+  const std::vector<uint32_t> v32 = {0x12345678, 0x9ABCDEF0, 1, 2, 3};
+  const std::array<uint16_t, 3> a16 = {0x1234, 0x5678, 0x9ABC};
+  xlib::gbin gb;
+  gb << v32 << a16;
+  xlib::gbin gx;
+  for (const auto v : v32) gx << v;
+  for (const auto v : a16) gx << v;
+  done = gb == gx;
+
+  std::vector<uint32_t> r32(v32.size());
+  std::array<uint16_t, 3> r16;
+  xlib::gbin_view gv(gb);
+  gv >> r32 >> r16;
+  done = done && r32 == v32 && r16 == a16 && gv.empty();
+  gb >> r32;
+  done = done && r32 == v32 && gb.size() == sizeof(a16);
+
+  xlib::vbin vb;
+  vb << v32;
+  xlib::vbin vx;
+  for (const auto v : v32) vx << v;
+  done = done && vb == vx;
+  std::vector<uint32_t> rv(v32.size());
+  vb >> rv;
+  done = done && rv == v32 && vb.empty();
+
+#ifdef __cpp_lib_span
+  xlib::lbin lb;
+  lb << std::span<const uint32_t>(v32.data(), 2);
+  uint32_t r[2];
+  xlib::lbin_view(lb) >> std::span<uint32_t>(r);
+  done = done && lb.size() == 8 && r[0] == v32[0] && r[1] == v32[1];
+#endif
+  try {
+    gb >> r32;
+    done = false;
+  } catch (...) {
+    done = done && gb.size() == sizeof(a16);
+  }
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xbin_sg);
+{
+  const std::string big(0x200, 'x');
+  xlib::gbin nested;
+  nested << std::string(0x300, 'y');
+  const uint8_t raw[] = {1, 2, 3};
+
+  xlib::gbin_sg sg;
+  sg << (uint32_t)0x12345678 << big << "ab" << nested << (uint16_t)0x55AA
+     << std::string("small") << nested << xlib::gbin() << true;
+  sg.ref(raw, sizeof(raw));
+  sg << (uint8_t)0xFF;
+
+  xlib::gbin gb;
+  gb << (uint32_t)0x12345678 << big << "ab" << nested << (uint16_t)0x55AA
+     << std::string("small") << nested << xlib::gbin() << true;
+  gb.append(raw, sizeof(raw));
+  gb << (uint8_t)0xFF;
+
+  const auto iov = sg.iov();
+  done = sg.size() == gb.size() && sg.to_bin() == gb && iov.size() == 9 &&
+         iov[1].iov_base == big.data() && iov[3].iov_base == nested.data() &&
+         iov[7].iov_base == raw;
+
+  xlib::vbin_sg vs(0x10);
+  xlib::vbin vn;
+  vn << std::string(0x20, 'z');
+  vs << vn << (int64_t)-1;
+  xlib::vbin vb;
+  vb << vn << (int64_t)-1;
+  done = done && vs.to_bin() == vb && vs.iov().size() == 3;
+  vs.clear();
+  done = done && vs.empty() && vs.iov().empty();
+
+  // 临时数据不可被引用，须复制。
+  const auto make = [] {
+    xlib::gbin b;
+    b << std::string(0x300, 'w');
+    return b;
+  };
+  xlib::gbin_sg ts;
+  ts << std::string(0x400, 't') << make();
+  xlib::gbin tb;
+  tb << std::string(0x400, 't') << make();
+  done = done && ts.iov().size() == 1 && ts.to_bin() == tb;
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(XBIN_FIELDS);
+{
+  static_assert(xlib::xbin_schema<xbin_test::Msg>::size == 4 + 2 + 1 + 6 + 8);
+  static_assert(xlib::xbin_schema<xbin_test::Var>::size == 0);
+  const xbin_test::Msg msg = {{0x12345678, -2}, 0xA5, {1, 2, 0x8001}, 0x1122334455667788};
+  xlib::gbin gb;
+  gb << msg;
+  xlib::gbin gx;
+  gx << msg.head.id << msg.head.code << msg.flag << msg.vals << msg.stamp;
+  done = gb == gx;
+
+  xbin_test::Msg rm = {};
+  xlib::gbin_view(gb) >> rm;
+  done = done && rm.head.id == msg.head.id && rm.head.code == msg.head.code &&
+         rm.flag == msg.flag && rm.vals == msg.vals && rm.stamp == msg.stamp;
+  rm = {};
+  gb >> rm;
+  done = done && gb.empty() && rm.vals == msg.vals && rm.stamp == msg.stamp;
+
+  xlib::vbin vb;
+  vb << msg;
+  xlib::vbin vx;
+  vx << msg.head.id << msg.head.code << msg.flag << msg.vals << msg.stamp;
+  done = done && vb == vx;
+  rm = {};
+  vb >> rm;
+  done = done && rm.head.code == msg.head.code &&
+         rm.stamp == msg.stamp && vb.empty();
+
+  xbin_test::Var var;
+  var.id = 7;
+  var.body << "body";
+  gb << var;
+  xbin_test::Var rv;
+  gb >> rv;
+  done = done && rv.id == 7 && rv.body == var.body && gb.empty();
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xbin_reader error);
+{
+  const uint8_t buf[] = {0x12, 0x34, 0x56};
+  xlib::gbin_view gv(buf, sizeof(buf));
+  uint16_t w = 0;
+  uint32_t d = 0;
+  uint8_t b = 0;
+  gv.nothrow() >> w >> d >> b;
+  done = !gv.ok() && !gv && gv.error() == xlib::gbin_view::XBE_NotEnough &&
+         gv.error_pos() == 2 && gv.pos() == 2 && w == 0x1234 && b == 0;
+  gv.clear_error() >> b;
+  done = done && gv.ok() && b == 0x56 && gv.empty();
+
+  const uint8_t over[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x02};
+  xlib::vbin_view vv(over, sizeof(over));
+  vv.nothrow() >> d >> b;
+  done = done && vv.error() == xlib::vbin_view::XBE_DataError &&
+         vv.error_pos() == 0 && b == 0x56;
+
+  xlib::vbin_view tv(over, 3);
+  std::vector<uint32_t> ds(1);
+  tv.nothrow() >> ds;
+  done = done && !tv.ok();
+
+  xlib::gbin_view ev(buf, sizeof(buf));
+  try {
+    ev >> d;
+    done = false;
+  } catch (...) {
+    done = done && ev.error() == xlib::gbin_view::XBE_NotEnough;
+  }
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xbin_splitter);
+{
+  std::vector<std::string> frames = {"", "a", std::string(300, 'b'), "cd",
+                                     std::string(200, 'e')};
+  xlib::gbin gs;
+  xlib::vbin vs;
+  for (const auto& f : frames) {
+    gs << (xlib::gbin() << f);
+    vs << (xlib::vbin() << f);
+  }
+
+  done = true;
+  for (size_t step = 1; step <= gs.size(); step = step * 3 + 1) {
+    xlib::gbin_splitter gsp;
+    xlib::vbin_splitter vsp;
+    std::vector<std::string> gout;
+    std::vector<std::string> vout;
+    xlib::gbin_view gf;
+    xlib::vbin_view vf;
+    for (size_t i = 0; i < gs.size(); i += step) {
+      gsp.feed(gs.data() + i, std::min(step, gs.size() - i));
+      while (gsp.next(gf)) gout.emplace_back((const char*)gf.data(), gf.remain());
+    }
+    for (size_t i = 0; i < vs.size(); i += step) {
+      vsp.feed(vs.data() + i, std::min(step, vs.size() - i));
+      while (vsp.next(vf)) vout.emplace_back((const char*)vf.data(), vf.remain());
+    }
+    done = done && gout == frames && vout == frames && !gsp.bad() &&
+           0 == gsp.buffered() && 0 == vsp.buffered();
+  }
+
+  // 整块输入时，数据帧直接引用输入。
+  xlib::gbin_splitter sp;
+  xlib::gbin_view f;
+  sp.feed(gs.data(), gs.size());
+  done = done && sp.next(f) && sp.next(f) && f.data() == gs.data() + 4;
+
+  xlib::gbin_splitter lim(0x100);
+  lim.feed(gs.data(), gs.size());
+  done = done && lim.next(f) && lim.next(f) && !lim.next(f) && lim.bad();
+
+  const uint8_t bad[] = {0x01, 0x00, 0x00};
+  xlib::xbin_splitter<uint16_t, true, false, false> self;
+  xlib::xbin_reader<uint16_t, true, false, false> sf;
+  self.feed(bad, sizeof(bad));
+  done = done && !self.next(sf) && self.bad();
+
+  // 取出一帧后复用数据块：先 hold ，余下数据帧不丢失。
+  xlib::gbin two;
+  two << (xlib::gbin() << std::string("first"))
+      << (xlib::gbin() << std::string("second"));
+  std::string chunk((const char*)two.data(), two.size());
+  xlib::gbin_splitter hs;
+  const auto str = [](const xlib::gbin_view& x) {
+    return std::string((const char*)x.data(), x.remain());
+  };
+  hs.feed(chunk.data(), chunk.size());
+  done = done && hs.next(f) && str(f) == "first";
+  hs.hold();
+  chunk.assign(chunk.size(), '\0');
+  done = done && hs.next(f) && str(f) == "second" && !hs.next(f) &&
+         !hs.bad() && 0 == hs.buffered();
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xdelta);
+{
+  std::vector<uint64_t> ids(300);
+  for (size_t i = 0; i < ids.size(); ++i) ids[i] = 0x100000000 + i * 3;
+  xlib::vbin vb;
+  vb << xlib::xdelta(ids) << (uint8_t)0x55 << xlib::xdelta(ids, true);
+  std::vector<uint64_t> r1(ids.size());
+  std::vector<uint64_t> r2(ids.size());
+  uint8_t b = 0;
+  xlib::vbin_view(vb) >> xlib::xdelta(r1) >> b >> xlib::xdelta(r2, true);
+  done = r1 == ids && r2 == ids && b == 0x55 && vb.size() < ids.size() + 64;
+  r1.assign(r1.size(), 0);
+  vb >> xlib::xdelta(r1) >> b;
+  done = done && r1 == ids && vb.size() > 0;
+  vb.resize(vb.size() - 1);
+  try {
+    vb >> xlib::xdelta(r2, true);
+    done = false;
+  } catch (...) {
+  }
+}
+SHOW_TEST_RESULT;
+
 SHOW_TEST_DONE;
\ No newline at end of file
@@ -2,7 +2,7 @@
   \file  xbin.h
   \brief 定义了便捷数据组织的类，常用于封包的组织与解析。
 
-  \version    2.1.1.230227
+  \version    2.11.0.261019
 
   \author     triones
   \date       2010-03-26
@@ -86,29 +86,301 @@
   - 2019-10-17 重构，升级为 xbin 。 2.0 。
   - 2019-11-06 再次重构，合并 vbin 。 2.1 。
   - 2020-03-13 适配 varint 优化。 2.1.1 。
+  - 2026-10-19 新增 xbin_reader ，以游标读取数据，避免 erase 。 2.2 。
+  - 2026-10-19 xbin_reader 支持外部缓冲，可读出嵌套数据视图。 2.3 。
+  - 2026-10-19 新增 open_head 、 close_head ，预留数据头并回填。 2.4 。
+  - 2026-10-19 新增模板参数 alloc ，允许指定分配器。 2.5 。
+  - 2026-10-19 新增整数数组的批量输入输出。 2.6 。
+  - 2026-10-19 vbin 数组批量编解码。 2.6.1 。
+  - 2026-10-19 新增 xbin_sg ，大块数据以引用组织，输出 iovec 。 2.7 。
+  - 2026-10-19 新增 XBIN_FIELDS ，按结构描述输入输出。 2.8 。
+  - 2026-10-19 xbin_reader 新增错误状态，可不抛出异常。 2.9 。
+  - 2026-10-19 新增 xbin_splitter ，从数据流中分离完整数据帧。 2.10 。
+  - 2026-10-19 vbin 以 xvarint_decode 有界解码，不再越界读取。 2.10.1 。
+  - 2026-10-19 支持 xdelta 差值编码整数数组。 2.11 。
 */
 #ifndef _XLIB_XBIN_H_
 #define _XLIB_XBIN_H_
 
 #include <string.h>
 
+#include <algorithm>
+#include <array>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+#if __has_include(<span>)
+#include <span>
+#endif
+
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
 
 #include "xswap.h"
 #include "xvarint.h"
 
+/**
+  描述结构的字段，之后可直接 xbin << msg 、 xbin >> msg 。
+
+  - 在结构所在的命名空间中使用，字段需可访问，最多 32 个。
+  - 字段可以是整数、枚举、 std::array 整数数组、另一个 XBIN_FIELDS 描述的结构，
+    或其它 xbin 支持的类型。
+  - 字段都是定长时，编译期计算总大小，一次分配，按固定偏移写入、读出。
+
+  \code
+    struct Msg {
+      uint32_t id;
+      uint16_t len;
+      std::array<uint8_t, 4> tag;
+    };
+    XBIN_FIELDS(Msg, id, len, tag)
+
+    bin << msg;
+    reader >> msg;
+  \endcode
+*/
+#define XBIN_FIELDS(TYPE, ...)                                        \
+  [[maybe_unused]] inline constexpr auto xbin_fields(const TYPE*) {   \
+    return std::make_tuple(XBIN_EXPAND(                               \
+        XBIN_CAT(XBIN_FIELD_, XBIN_NARG(__VA_ARGS__))(TYPE, __VA_ARGS__))); \
+  }
+
+// MSVC 的 __VA_ARGS__ 作为单个参数传递，需要 XBIN_EXPAND 再次展开。
+#define XBIN_EXPAND(x) x
+#define XBIN_CAT_(a, b) a##b
+#define XBIN_CAT(a, b) XBIN_CAT_(a, b)
+#define XBIN_NARG_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
+#define XBIN_NARG(...) \
+  XBIN_EXPAND(XBIN_NARG_(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define XBIN_FIELD_1(TYPE, x) &TYPE::x
+#define XBIN_FIELD_2(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_1(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_3(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_2(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_4(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_3(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_5(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_4(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_6(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_5(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_7(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_6(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_8(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_7(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_9(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_8(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_10(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_9(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_11(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_10(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_12(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_11(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_13(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_12(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_14(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_13(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_15(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_14(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_16(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_15(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_17(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_16(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_18(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_17(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_19(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_18(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_20(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_19(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_21(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_20(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_22(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_21(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_23(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_22(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_24(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_23(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_25(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_24(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_26(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_25(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_27(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_26(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_28(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_27(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_29(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_28(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_30(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_29(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_31(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_30(TYPE, __VA_ARGS__))
+#define XBIN_FIELD_32(TYPE, x, ...) \
+  &TYPE::x, XBIN_EXPAND(XBIN_FIELD_31(TYPE, __VA_ARGS__))
+
 namespace xlib {
 
+/// 取成员指针的成员类型。
+template <typename M>
+struct xbin_member;
+template <typename C, typename M>
+struct xbin_member<M C::*> {
+  using type = M;
+};
+
+template <typename T>
+struct xbin_is_array : std::false_type {};
+template <typename T, size_t N>
+struct xbin_is_array<std::array<T, N>> : std::true_type {};
+
+/**
+  XBIN_FIELDS 描述的结构信息。
+
+  - valid   是否有描述。
+  - fields  成员指针 tuple 。
+  - size    定长结构的总大小，有变长字段时为 0 。
+*/
+template <typename T, typename = void>
+struct xbin_schema {
+  static constexpr bool valid = false;
+  static constexpr size_t size = 0;
+};
+
+/// 定长类型的编码大小，变长类型为 0 。
+template <typename T>
+constexpr size_t xbin_fixed_size() {
+  if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+    return sizeof(T);
+  } else if constexpr (xbin_is_array<T>::value) {
+    using U = typename T::value_type;
+    if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+      return sizeof(U) * std::tuple_size_v<T>;
+    } else {
+      return 0;
+    }
+  } else {
+    return xbin_schema<T>::size;
+  }
+}
+
+template <typename T>
+struct xbin_schema<T, std::void_t<decltype(xbin_fields((const T*)nullptr))>> {
+  static constexpr bool valid = true;
+  static constexpr auto fields = xbin_fields((const T*)nullptr);
+  static constexpr size_t count =
+      std::tuple_size_v<std::remove_const_t<decltype(fields)>>;
+  template <size_t I>
+  using field_type = typename xbin_member<
+      std::tuple_element_t<I, std::remove_const_t<decltype(fields)>>>::type;
+
+ private:
+  template <size_t... I>
+  static constexpr std::array<size_t, count + 1> make_offsets(
+      std::index_sequence<I...>) {
+    const size_t sizes[] = {xbin_fixed_size<field_type<I>>()..., 0};
+    std::array<size_t, count + 1> offs = {};
+    for (size_t i = 0; i < count; ++i) {
+      if (0 == sizes[i]) return {};
+      offs[i + 1] = offs[i] + sizes[i];
+    }
+    return offs;
+  }
+
+ public:
+  /// 各字段偏移，最后一项为总大小。有变长字段时全为 0 。
+  static constexpr auto offsets = make_offsets(std::make_index_sequence<count>());
+  static constexpr size_t size = offsets[count];
+};
+
+template <bool bigendian, typename T>
+inline void xbin_store(uint8_t* const p, const T& v);
+template <bool bigendian, typename T>
+inline void xbin_load(const uint8_t* const p, T& v);
+
+template <bool bigendian, typename T, size_t... I>
+inline void xbin_store_fields(uint8_t* const p, const T& v,
+                              std::index_sequence<I...>) {
+  using S = xbin_schema<T>;
+  (xbin_store<bigendian>(p + S::offsets[I], v.*std::get<I>(S::fields)), ...);
+}
+template <bool bigendian, typename T, size_t... I>
+inline void xbin_load_fields(const uint8_t* const p, T& v,
+                             std::index_sequence<I...>) {
+  using S = xbin_schema<T>;
+  (xbin_load<bigendian>(p + S::offsets[I], v.*std::get<I>(S::fields)), ...);
+}
+
+/// 按固定偏移写入定长类型。 p 需有 xbin_fixed_size<T>() 大小。
+template <bool bigendian, typename T>
+inline void xbin_store(uint8_t* const p, const T& v) {
+  if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+    const auto x = bigendian ? bswap(v) : v;
+    memcpy(p, &x, sizeof(x));
+  } else if constexpr (xbin_is_array<T>::value) {
+    using U = typename T::value_type;
+    if constexpr (bigendian) {
+      bswaps<U>(p, v.data(), v.size());
+    } else {
+      memcpy(p, v.data(), sizeof(U) * v.size());
+    }
+  } else {
+    xbin_store_fields<bigendian>(
+        p, v, std::make_index_sequence<xbin_schema<T>::count>());
+  }
+}
+
+/// 按固定偏移读出定长类型。 p 需有 xbin_fixed_size<T>() 大小。
+template <bool bigendian, typename T>
+inline void xbin_load(const uint8_t* const p, T& v) {
+  if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+    memcpy(&v, p, sizeof(v));
+    v = bigendian ? bswap(v) : v;
+  } else if constexpr (xbin_is_array<T>::value) {
+    using U = typename T::value_type;
+    if constexpr (bigendian) {
+      bswaps<U>(v.data(), p, v.size());
+    } else {
+      memcpy(v.data(), p, sizeof(U) * v.size());
+    }
+  } else {
+    xbin_load_fields<bigendian>(
+        p, v, std::make_index_sequence<xbin_schema<T>::count>());
+  }
+}
+
 /**
   xbin 用于便捷的数据组织操作。
   \param  headtype    数据头类型， byte , word , dword , qword , void。
   \param  headself    指示数据头是否包含自身长度。
   \param  bigendian   输入输出的数据是否转换成大端序（默认小端）。
   \param  zeroend     指示处理流时是否追加处理结尾 0 。
+  \param  alloc       分配器。可使用 xpool_allocator 或 std::pmr::polymorphic_allocator 。
 */
-template <typename headtype, bool headself, bool bigendian, bool zeroend>
-class xbin : public std::basic_string<uint8_t> {
+template <typename headtype, bool headself, bool bigendian, bool zeroend,
+          typename alloc = std::allocator<uint8_t>>
+class xbin
+    : public std::basic_string<uint8_t, std::char_traits<uint8_t>, alloc> {
+ public:
+  using base = std::basic_string<uint8_t, std::char_traits<uint8_t>, alloc>;
+  using typename base::const_pointer;
+  using base::append;
+  using base::assign;
+  using base::begin;
+  using base::c_str;
+  using base::clear;
+  using base::data;
+  using base::end;
+  using base::erase;
+  using base::insert;
+  using base::size;
+
+ public:
+  xbin() = default;
+  explicit xbin(const alloc& a) : base(a) {}
+
  public:
   /*========================  数据输入  ========================*/
   /**
@@ -189,6 +461,69 @@ class xbin : public std::basic_string<uint8_t> {
     }
     return *this;
   }
+  /**
+    整数数组批量输入。只输入元素，不输入元素个数。
+
+    - 一次分配。本机序直接复制，大端序批量翻转。
+    - vbin 以 xvarints_encode 批量编码。
+
+    \code
+      xbin << std::vector<uint32_t>{1, 2, 3};
+      xbin << std::array<uint16_t, 4>{};
+    \endcode
+  */
+  template <typename T, typename A>
+  std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, xbin>&
+  operator<<(const std::vector<T, A>& v) {
+    return append_array(v.data(), v.size());
+  }
+  template <typename T, size_t N>
+  std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, xbin>&
+  operator<<(const std::array<T, N>& v) {
+    return append_array(v.data(), v.size());
+  }
+#ifdef __cpp_lib_span
+  template <typename T, size_t E>
+  std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, xbin>&
+  operator<<(const std::span<T, E> v) {
+    return append_array(v.data(), v.size());
+  }
+#endif
+  /**
+    整数数组差值编码输入。编码格式与 headtype 无关。
+
+    \code
+      xbin << xlib::xdelta(ids);
+    \endcode
+  */
+  template <typename T>
+  xbin& operator<<(const xdelta<T>& d) {
+    const auto pos = size();
+    base::resize(pos + d.max_size());
+    const auto e = d.encode(data() + pos);
+    base::resize(e - data());
+    return *this;
+  }
+  /**
+    XBIN_FIELDS 描述的结构，逐字段输入。定长结构一次分配，按固定偏移写入。
+
+    \code
+      xbin << msg;
+    \endcode
+  */
+  template <typename T>
+  std::enable_if_t<xbin_schema<T>::valid, xbin>& operator<<(const T& v) {
+    using S = xbin_schema<T>;
+    if constexpr (!std::is_void_v<headtype> && S::size != 0) {
+      const auto pos = size();
+      base::resize(pos + S::size);
+      xbin_store<bigendian>(data() + pos, v);
+    } else {
+      std::apply([this, &v](const auto... m) { (operator<<(v.*m), ...); },
+                 S::fields);
+    }
+    return *this;
+  }
 
   xbin& mkhead() {
     if constexpr (!std::is_void_v<headtype>) {
@@ -201,6 +536,50 @@ class xbin : public std::basic_string<uint8_t> {
     }
     return *this;
   }
+  /// 数据头预留大小。 vbin 为 size_t 的 varint 最大长度。
+  static constexpr size_t head_size() {
+    if constexpr (!std::is_void_v<headtype>) {
+      return sizeof(headtype);
+    } else {
+      return (sizeof(size_t) * CHAR_BIT + (CHAR_BIT - 2)) / (CHAR_BIT - 1);
+    }
+  }
+  /**
+    预留数据头，返回数据头位置。之后写入的数据，由 close_head 回填数据头。
+
+    - 相比 mkhead 、 << xbin ，无需移动或复制数据。
+    - 可嵌套使用，各层以各自位置回填。
+    - vbin 的数据头以冗余的 0x80 补齐 varint 最大长度，与 xvarint 解码兼容。
+
+    \code
+      const auto pos = bin.open_head();
+      bin << dword << word;
+      bin.close_head(pos);  // 等价于 bin << (xbin() << dword << word) 。
+    \endcode
+  */
+  size_t open_head() {
+    const auto pos = size();
+    append(head_size(), 0);
+    return pos;
+  }
+  /// 回填 open_head 预留的数据头。
+  xbin& close_head(const size_t pos) {
+    const size_t nlen = size() - pos - head_size();
+    const auto p = data() + pos;
+    if constexpr (!std::is_void_v<headtype>) {
+      const auto xlen = (headtype)(nlen + (headself ? sizeof(headtype) : 0));
+      const auto v = (bigendian ? bswap(xlen) : xlen);
+      memcpy(p, &v, sizeof(v));
+    } else {
+      auto v = nlen;
+      for (size_t i = 0; i < head_size() - 1; ++i) {
+        p[i] = (uint8_t)(v & 0x7F) | 0x80;
+        v >>= (CHAR_BIT - 1);
+      }
+      p[head_size() - 1] = (uint8_t)(v & 0x7F);
+    }
+    return *this;
+  }
 
  public:
   /*========================  数据输出  ========================*/
@@ -318,11 +697,9 @@ class xbin : public std::basic_string<uint8_t> {
       erase(0, sizeof(T));
       argvs = bigendian ? bswap(argvs) : argvs;
     } else {
-      const xvarint<T> vi(data());
-      argvs = vi;
-      const size_t typesize = vi.size();
+      const size_t typesize = xvarint_decode(argvs, c_str(), c_str() + size());
 #ifndef XBIN_NOEXCEPT
-      if (typesize == 0 || typesize > size()) {
+      if (typesize == 0) {
         throw std::runtime_error("xbin >> T& not enough data / data error");
       }
 #endif
@@ -331,6 +708,78 @@ class xbin : public std::basic_string<uint8_t> {
 
     return *this;
   }
+  /**
+    整数数组批量输出。按容器当前元素个数读取。
+
+    \code
+      std::vector<uint32_t> v(3);
+      xbin >> v;
+    \endcode
+    \exception 数据不足时，抛出 runtime_error 异常。
+  */
+  template <typename T, typename A>
+  std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, xbin>&
+  operator>>(std::vector<T, A>& v) {
+    return remove_array(v.data(), v.size());
+  }
+  template <typename T, size_t N>
+  std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, xbin>&
+  operator>>(std::array<T, N>& v) {
+    return remove_array(v.data(), v.size());
+  }
+#ifdef __cpp_lib_span
+  template <typename T, size_t E>
+  std::enable_if_t<(std::is_integral_v<T> || std::is_enum_v<T>) &&
+                       !std::is_const_v<T>,
+                   xbin>&
+  operator>>(const std::span<T, E> v) {
+    return remove_array(v.data(), v.size());
+  }
+#endif
+  /**
+    整数数组差值编码输出。按数组当前元素个数读取。
+
+    \code
+      xbin >> xlib::xdelta(ids);
+    \endcode
+    \exception 数据不足或数据错误时，抛出 runtime_error 异常。
+  */
+  template <typename T>
+  std::enable_if_t<!std::is_const_v<T>, xbin>& operator>>(const xdelta<T>& d) {
+    const auto e = d.decode(c_str(), c_str() + size());
+#ifndef XBIN_NOEXCEPT
+    if (e == nullptr) {
+      throw std::runtime_error("xbin >> xdelta not enough data / data error");
+    }
+#endif
+    erase(0, (e == nullptr) ? size() : (size_t)(e - c_str()));
+    return *this;
+  }
+  /**
+    XBIN_FIELDS 描述的结构，逐字段输出。定长结构按固定偏移读出。
+
+    \code
+      xbin >> msg;
+    \endcode
+    \exception 数据不足时，抛出 runtime_error 异常。
+  */
+  template <typename T>
+  std::enable_if_t<xbin_schema<T>::valid, xbin>& operator>>(T& v) {
+    using S = xbin_schema<T>;
+    if constexpr (!std::is_void_v<headtype> && S::size != 0) {
+#ifndef XBIN_NOEXCEPT
+      if (S::size > size()) {
+        throw std::runtime_error("xbin >> schema not enough data");
+      }
+#endif
+      xbin_load<bigendian>(c_str(), v);
+      erase(0, S::size);
+    } else {
+      std::apply([this, &v](const auto... m) { (operator>>(v.*m), ...); },
+                 S::fields);
+    }
+    return *this;
+  }
   /**
     目的用以跳过某些不需要的数据。
 
@@ -354,6 +803,749 @@ class xbin : public std::basic_string<uint8_t> {
       return operator>>(argvs);
     }
   }
+
+ private:
+  template <typename T>
+  xbin& append_array(const T* const p, const size_t n) {
+    if constexpr (!std::is_void_v<headtype>) {
+      const auto pos = size();
+      base::resize(pos + n * sizeof(T));
+      if constexpr (bigendian) {
+        bswaps<T>(data() + pos, p, n);
+      } else {
+        memcpy(data() + pos, p, n * sizeof(T));
+      }
+    } else {
+      const auto pos = size();
+      base::resize(pos + n * xvarint_max<T>);
+      const auto e = xvarints_encode(data() + pos, p, n);
+      base::resize(e - data());
+    }
+    return *this;
+  }
+  template <typename T>
+  xbin& remove_array(T* const p, const size_t n) {
+    if constexpr (!std::is_void_v<headtype>) {
+      const size_t nlen = n * sizeof(T);
+#ifndef XBIN_NOEXCEPT
+      if (nlen > size()) {
+        throw std::runtime_error("xbin >> T[] not enough data");
+      }
+#endif
+      if constexpr (bigendian) {
+        bswaps<T>(p, c_str(), n);
+      } else {
+        memcpy(p, c_str(), nlen);
+      }
+      erase(0, nlen);
+    } else {
+      const auto e = xvarints_decode(p, n, c_str(), c_str() + size());
+#ifndef XBIN_NOEXCEPT
+      if (e == nullptr) {
+        throw std::runtime_error("xbin >> T[] not enough data / data error");
+      }
+#endif
+      erase(0, (e == nullptr) ? size() : (size_t)(e - c_str()));
+    }
+    return *this;
+  }
+};
+
+/**
+  xbin_reader 以游标方式读取数据。
+
+  - 读取只推进游标，不修改、不复制源数据，避免 xbin >> 每次 erase 的内存移动。
+  - 输出操作与 xbin 一致，模板参数与 xbin 一致。
+  - 源数据可以是 xbin ，也可以是外部缓冲（如 socket 缓冲、映射文件）。
+  - 读取期间，源数据需保持有效且不变。
+  - 数据不足时，默认抛出 runtime_error 异常。
+  - 出错后记录错误（不论是否抛出异常），之后的读取都不进行，直到 clear_error 。
+  - nothrow 或定义 XBIN_NOEXCEPT 时，出错不抛出异常，以 ok 、 error 检查。
+
+  \code
+    xlib::gbin bin;
+    xlib::xbin_reader reader(bin);
+    reader >> dword >> word >> byte;
+
+    xlib::gbin_view view(buf, len);   // 直接读取外部缓冲。
+    xlib::gbin_view sub;
+    view >> sub;                      // 嵌套数据不复制。
+
+    view.nothrow() >> dword >> word;  // 不抛出异常，读取完毕再检查。
+    if (!view.ok()) return view.error_pos();
+  \endcode
+*/
+template <typename headtype, bool headself, bool bigendian, bool zeroend>
+class xbin_reader {
+ public:
+  enum Error {
+    XBE_None,       //< 无错误。
+    XBE_NotEnough,  //< 数据不足。
+    XBE_DataError,  //< 数据错误，如 varint 超长。
+  };
+
+ public:
+  xbin_reader() : _data(nullptr), _size(0), _pos(0) {}
+  xbin_reader(const void* const p, const size_t size)
+      : _data((const uint8_t*)p), _size(size), _pos(0) {}
+  template <typename alloc>
+  xbin_reader(const xbin<headtype, headself, bigendian, zeroend, alloc>& b)
+      : xbin_reader(b.data(), b.size()) {}
+  template <typename T>
+  xbin_reader(const std::basic_string_view<T> s)
+      : xbin_reader(s.data(), s.size() * sizeof(T)) {}
+#ifdef __cpp_lib_span
+  template <typename T, size_t E>
+  xbin_reader(const std::span<T, E> s) : xbin_reader(s.data(), s.size_bytes()) {}
+#endif
+  /// 返回当前读取位置。
+  const uint8_t* data() const { return _data + _pos; }
+  /// 返回已读取字节数。
+  size_t pos() const { return _pos; }
+  /// 返回剩余字节数。
+  size_t remain() const { return _size - _pos; }
+  bool empty() const { return _pos >= _size; }
+  /// 回退指定字节数，默认回到起始。
+  xbin_reader& rewind(const size_t n = SIZE_MAX) {
+    _pos -= (n < _pos) ? n : _pos;
+    return *this;
+  }
+  /// 是否无错误。
+  bool ok() const { return XBE_None == _error; }
+  explicit operator bool() const { return ok(); }
+  /// 返回首个错误。
+  Error error() const { return _error; }
+  /// 返回首个错误发生时的读取位置。
+  size_t error_pos() const { return _errpos; }
+  /// 清除错误，允许继续读取。
+  xbin_reader& clear_error() {
+    _error = XBE_None;
+    _errpos = 0;
+    return *this;
+  }
+  /// 设置出错时是否抛出异常。
+  xbin_reader& nothrow(const bool b = true) {
+    _throw = !b;
+    return *this;
+  }
+  /**
+    跳过指定字节数。
+    \exception  数据不足时，抛出 runtime_error 异常。
+  */
+  xbin_reader& skip(const size_t n) {
+    if (need(n, "xbin_reader skip not enough data")) _pos += n;
+    return *this;
+  }
+
+ public:
+  /*========================  数据输出  ========================*/
+  /**
+    \code
+      reader >> (void*)p;
+    \endcode
+  */
+  xbin_reader& operator>>(void*& p) {
+    return operator>>((size_t&)p);
+  }
+  /**
+    \code
+      bool b;
+      reader >> b;
+    \endcode
+  */
+  xbin_reader& operator>>(bool& b) {
+    return operator>>(*(uint8_t*)&b);
+  }
+  /**
+    \code
+      reader >> (char*)lpstr;
+    \endcode
+    \exception  数据不足时，抛出 runtime_error 异常。
+    \note       允许空指针，这样将丢弃一串指定类型的数据。
+  */
+  template <typename T>
+  xbin_reader& operator>>(T* str) {
+    const T* lpstr = (const T*)data();
+    const size_t maxlen = remain() / sizeof(T);
+
+    // 源数据不保证结尾 0 ，查找不越界。找不到时，视作结尾有 0 ，与 xbin 一致。
+    size_t strlen = 0;
+    T ch;
+    for (; strlen < maxlen; ++strlen) {
+      memcpy(&ch, lpstr + strlen, sizeof(T));
+      if (!ch) break;
+    }
+    if constexpr (!std::is_void_v<headtype>) strlen += zeroend ? 1 : 0;
+    strlen *= sizeof(T);
+
+    if (!need(strlen, "xbin_reader >> T* not enough data")) return *this;
+
+    if (nullptr != str) memcpy(str, lpstr, strlen);
+
+    _pos += strlen;
+
+    return *this;
+  }
+  /**
+    \code
+      reader >> xbin;
+    \endcode
+    \exception  数据不足时，抛出 runtime_error 异常。
+  */
+  template <typename alloc>
+  xbin_reader& operator>>(
+      xbin<headtype, headself, bigendian, zeroend, alloc>& b) {
+    size_t nlen;
+    if (!head(nlen)) return *this;
+
+    if (!need(nlen, "xbin_reader >> xbin& not enough data")) return *this;
+
+    b.assign(data(), nlen);
+    _pos += nlen;
+
+    return *this;
+  }
+  /**
+    读取嵌套数据为视图，不复制。
+
+    \code
+      reader >> sub;
+    \endcode
+    \exception  数据不足时，抛出 runtime_error 异常。
+    \note       当操作自身时，按数据头长度截断。
+  */
+  xbin_reader& operator>>(xbin_reader& sub) {
+    size_t nlen;
+    if (!head(nlen)) return *this;
+
+    if (!need(nlen, "xbin_reader >> xbin_reader& not enough data")) {
+      return *this;
+    }
+
+    if (&sub == this) {
+      _size = _pos + nlen;
+      return *this;
+    }
+
+    sub = xbin_reader(data(), nlen);
+    sub._throw = _throw;
+    _pos += nlen;
+
+    return *this;
+  }
+  /**
+    模板适用于标准库字符串。数据倾倒。
+
+    \code
+      reader >> string;
+    \endcode
+  */
+  template <typename T>
+  xbin_reader& operator>>(std::basic_string<T>& s) {
+    if (!need(0, "xbin_reader >> basic_string after error")) return *this;
+    s.assign((const T*)data(), remain() / sizeof(T));
+    _pos = _size;
+    return *this;
+  }
+  /**
+    模板适用于内置类型，结构体等。
+
+    \code
+      reader >> dword >> word >> byte;
+    \endcode
+    \exception 数据不足时，抛出 runtime_error 异常。
+  */
+  template <typename T>
+  inline std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>,
+                          xbin_reader>&
+  operator>>(T& argvs) {
+    if constexpr (!std::is_void_v<headtype>) {
+      if (!need(sizeof(T), "xbin_reader >> T& not enough data")) return *this;
+      memcpy(&argvs, data(), sizeof(T));
+      _pos += sizeof(T);
+      argvs = bigendian ? bswap(argvs) : argvs;
+    } else {
+      if (!need(1, "xbin_reader >> T& not enough data")) return *this;
+      const size_t typesize = xvarint_decode(argvs, data(), _data + _size);
+      if (typesize == 0) {
+        if (remain() < xvarint_max<T>) {
+          fail(XBE_NotEnough, "xbin_reader >> T& not enough data");
+        } else {
+          fail(XBE_DataError, "xbin_reader >> T& data error");
+        }
+        return *this;
+      }
+      _pos += typesize;
+    }
+
+    return *this;
+  }
+  /**
+    整数数组批量输出。按容器当前元素个数读取。
+
+    \code
+      std::array<uint16_t, 4> a;
+      reader >> a;
+    \endcode
+    \exception 数据不足时，抛出 runtime_error 异常。
+  */
+  template <typename T, typename A>
+  std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, xbin_reader>&
+  operator>>(std::vector<T, A>& v) {
+    return read_array(v.data(), v.size());
+  }
+  template <typename T, size_t N>
+  std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, xbin_reader>&
+  operator>>(std::array<T, N>& v) {
+    return read_array(v.data(), v.size());
+  }
+#ifdef __cpp_lib_span
+  template <typename T, size_t E>
+  std::enable_if_t<(std::is_integral_v<T> || std::is_enum_v<T>) &&
+                       !std::is_const_v<T>,
+                   xbin_reader>&
+  operator>>(const std::span<T, E> v) {
+    return read_array(v.data(), v.size());
+  }
+#endif
+  /**
+    整数数组差值编码输出。按数组当前元素个数读取。
+
+    \code
+      reader >> xlib::xdelta(ids);
+    \endcode
+    \exception 数据不足或数据错误时，抛出 runtime_error 异常。
+  */
+  template <typename T>
+  std::enable_if_t<!std::is_const_v<T>, xbin_reader>& operator>>(
+      const xdelta<T>& d) {
+    if (!need(0, "xbin_reader >> xdelta after error")) return *this;
+    const auto e = d.decode(data(), _data + _size);
+    if (e == nullptr) {
+      fail(XBE_DataError, "xbin_reader >> xdelta not enough data / data error");
+      return *this;
+    }
+    _pos = e - _data;
+    return *this;
+  }
+  /**
+    XBIN_FIELDS 描述的结构，逐字段输出。定长结构按固定偏移读出。
+
+    \code
+      reader >> msg;
+    \endcode
+    \exception 数据不足时，抛出 runtime_error 异常。
+  */
+  template <typename T>
+  std::enable_if_t<xbin_schema<T>::valid, xbin_reader>& operator>>(T& v) {
+    using S = xbin_schema<T>;
+    if constexpr (!std::is_void_v<headtype> && S::size != 0) {
+      if (!need(S::size, "xbin_reader >> schema not enough data")) {
+        return *this;
+      }
+      xbin_load<bigendian>(data(), v);
+      _pos += S::size;
+    } else {
+      std::apply([this, &v](const auto... m) { (operator>>(v.*m), ...); },
+                 S::fields);
+    }
+    return *this;
+  }
+  /**
+    目的用以跳过某些不需要的数据。
+
+    \code
+      reader >> cnull >> snull >> 0;
+    \endcode
+    \exception 数据不足时，抛出 runtime_error 异常。
+  */
+  template <typename T>
+  xbin_reader& operator>>(const T&) {
+    if constexpr (!std::is_void_v<headtype>) {
+      return skip(sizeof(T));
+    } else {
+      T argvs;
+      return operator>>(argvs);
+    }
+  }
+
+ private:
+  /// 检查无错误且剩余数据足够。
+  bool need(const size_t n, const char* const msg) {
+    if (XBE_None == _error && n <= remain()) return true;
+    return fail(XBE_NotEnough, msg);
+  }
+  /// 记录首个错误，按设置抛出异常。
+  bool fail(const Error e, const char* const msg) {
+    if (XBE_None == _error) {
+      _error = e;
+      _errpos = _pos;
+    }
+    if (_throw) throw std::runtime_error(msg);
+    return false;
+  }
+  template <typename T>
+  xbin_reader& read_array(T* const p, const size_t n) {
+    if constexpr (!std::is_void_v<headtype>) {
+      const size_t nlen = n * sizeof(T);
+      if (!need(nlen, "xbin_reader >> T[] not enough data")) return *this;
+      if constexpr (bigendian) {
+        bswaps<T>(p, data(), n);
+      } else {
+        memcpy(p, data(), nlen);
+      }
+      _pos += nlen;
+    } else {
+      if (!need(0, "xbin_reader >> T[] after error")) return *this;
+      const auto e = xvarints_decode(p, n, data(), _data + _size);
+      if (e == nullptr) {
+        fail(XBE_DataError, "xbin_reader >> T[] not enough data / data error");
+        return *this;
+      }
+      _pos = e - _data;
+    }
+    return *this;
+  }
+  /// 读取数据头，返回数据长度。
+  bool head(size_t& nlen) {
+    if constexpr (!std::is_void_v<headtype>) {
+      headtype xlen = 0;
+      const auto pos = _pos;
+      operator>>(xlen);
+      if (pos == _pos) return false;
+
+      nlen = (headtype)xlen;
+      nlen -= (headself ? sizeof(headtype) : 0);
+    } else {
+      const auto pos = _pos;
+      operator>>(nlen);
+      if (pos == _pos) return false;
+    }
+    return true;
+  }
+
+ private:
+  const uint8_t*  _data;  //< 源数据。
+  size_t          _size;  //< 源数据大小。
+  size_t          _pos;   //< 游标。
+  Error           _error = XBE_None;  //< 首个错误。
+  size_t          _errpos = 0;        //< 首个错误的位置。
+#ifndef XBIN_NOEXCEPT
+  bool            _throw = true;      //< 出错时是否抛出异常。
+#else
+  bool            _throw = false;
+#endif
+};
+
+#ifdef _WIN32
+/// 与 iovec 布局一致。 Windows 下 WSABUF 字段顺序不同，需自行转换。
+struct xiovec {
+  void*   iov_base;
+  size_t  iov_len;
+};
+#else
+using xiovec = ::iovec;
+#endif
+
+/**
+  xbin_sg 用于分段组织数据，输出 iovec 数组，供 writev 、 sendmsg 使用。
+
+  - 小字段写入内部 xbin 。
+  - 不小于阈值的字符串、 xbin 数据，以及 ref 指定的数据，只记录引用，不复制。
+  - 被引用的数据需在 iov 使用完毕前保持有效且不变。
+  - 临时（右值）字符串、 xbin 总是复制写入内部 xbin ，不会留下悬空引用。
+  - 输出内容与同样操作 xbin 一致。
+
+  \code
+    xlib::gbin_sg sg;
+    sg << dword << big_string << word;
+    const auto iov = sg.iov();
+    writev(fd, iov.data(), (int)iov.size());
+  \endcode
+*/
+template <typename headtype, bool headself, bool bigendian, bool zeroend,
+          typename alloc = std::allocator<uint8_t>>
+class xbin_sg {
+ public:
+  using bin_type = xbin<headtype, headself, bigendian, zeroend, alloc>;
+
+ public:
+  /// \param threshold   不小于此大小的数据以引用组织。
+  explicit xbin_sg(const size_t threshold = 0x100) : _threshold(threshold) {}
+  /// 所有数据大小。
+  size_t size() const { return _bin.size() + _refsize; }
+  bool empty() const { return 0 == size(); }
+  void clear() {
+    _bin.clear();
+    _refs.clear();
+    _refsize = 0;
+  }
+  /// 引用一段数据，不复制。
+  xbin_sg& ref(const void* const p, const size_t n) {
+    if (0 == n) return *this;
+    _refs.push_back({_bin.size(), p, n});
+    _refsize += n;
+    return *this;
+  }
+  /**
+    输出 iovec 数组。
+
+    \note  内部 xbin 的地址在下次写入后可能失效，需重新获取。
+  */
+  std::vector<xiovec> iov() const {
+    std::vector<xiovec> v;
+    v.reserve(_refs.size() * 2 + 1);
+    size_t pos = 0;
+    for (const auto& r : _refs) {
+      if (r.off > pos) v.push_back(make_iov(_bin.data() + pos, r.off - pos));
+      v.push_back(make_iov(r.p, r.n));
+      pos = r.off;
+    }
+    if (_bin.size() > pos) {
+      v.push_back(make_iov(_bin.data() + pos, _bin.size() - pos));
+    }
+    return v;
+  }
+  /// 合并为连续数据。
+  bin_type to_bin() const {
+    bin_type b(_bin.get_allocator());
+    b.reserve(size());
+    for (const auto& i : iov()) {
+      b.append((const uint8_t*)i.iov_base, i.iov_len);
+    }
+    return b;
+  }
+
+ public:
+  /*========================  数据输入  ========================*/
+  /**
+    \code
+      const string s(0x1000, 'x');
+      sg << s;      // 引用 s 。
+    \endcode
+  */
+  template <typename T>
+  xbin_sg& operator<<(const std::basic_string<T>& s) {
+    const size_t n = s.size() * sizeof(T);
+    if (n < _threshold) {
+      _bin << s;
+      return *this;
+    }
+    return ref(s.data(), n);
+  }
+  /**
+    临时字符串总是复制。
+
+    \code
+      sg << string(0x1000, 'x');
+    \endcode
+  */
+  template <typename T>
+  xbin_sg& operator<<(std::basic_string<T>&& s) {
+    _bin << s;
+    return *this;
+  }
+  /**
+    \code
+      sg << xbin;
+    \endcode
+  */
+  xbin_sg& operator<<(const bin_type& b) {
+    if (b.size() < _threshold) {
+      _bin << b;
+      return *this;
+    }
+    if constexpr (!std::is_void_v<headtype>) {
+      _bin << (headtype)(b.size() + (headself ? sizeof(headtype) : 0));
+    } else {
+      _bin << b.size();
+    }
+    return ref(b.data(), b.size());
+  }
+  /// 临时 xbin 总是复制。
+  xbin_sg& operator<<(bin_type&& b) {
+    _bin << b;
+    return *this;
+  }
+  /// 其它数据写入内部 xbin 。
+  template <typename T>
+  xbin_sg& operator<<(const T& v) {
+    _bin << v;
+    return *this;
+  }
+
+ private:
+  static xiovec make_iov(const void* const p, const size_t n) {
+    xiovec v;
+    v.iov_base = (void*)p;
+    v.iov_len = n;
+    return v;
+  }
+
+ private:
+  struct Ref {
+    size_t      off;  //< 引用插入位置，即当时内部 xbin 的大小。
+    const void* p;
+    size_t      n;
+  };
+  size_t            _threshold;
+  bin_type          _bin;
+  std::vector<Ref>  _refs;
+  size_t            _refsize = 0;
+};
+
+/**
+  xbin_splitter 用于从数据流（如 TCP ）中分离以数据头标识长度的数据帧。
+
+  - 数据帧格式与 xbin << xbin 一致，按模板参数解析数据头。
+  - 数据帧完整位于 feed 的数据块中时，直接返回其视图，不复制。
+  - 跨数据块的数据帧缓存在内部，补齐后返回内部缓存的视图。
+  - 数据块的视图在数据块释放前有效；内部缓存的视图在下次 next 、 feed 、 hold 前有效。
+  - feed 不复制数据块。数据块需保持有效、不变，直至 next 返回 false （此时未成帧的
+    数据已复制到内部缓存），或调用 hold 。
+    未取完数据帧即复用数据块（如下次 recv ），须先调用 hold ，否则余下数据帧丢失。
+  - 数据头错误或数据帧超过限制时，进入错误状态，不再返回数据帧。
+
+  \code
+    xlib::gbin_splitter sp;
+    while (recv(...)) {
+      sp.feed(buf, len);
+      xlib::gbin_view frame;
+      while (sp.next(frame)) frame >> dword >> word;
+      if (sp.bad()) break;
+      // 若提前跳出 next 循环，复用 buf 前需 sp.hold() 。
+    }
+  \endcode
+*/
+template <typename headtype, bool headself, bool bigendian, bool zeroend,
+          typename alloc = std::allocator<uint8_t>>
+class xbin_splitter {
+ public:
+  using reader_type = xbin_reader<headtype, headself, bigendian, zeroend>;
+
+ public:
+  /// \param max_frame   数据帧（不含数据头）的最大长度。
+  explicit xbin_splitter(const size_t max_frame = SIZE_MAX)
+      : _max_frame(max_frame) {}
+  /**
+    输入数据块。之后以 next 取出数据帧，直至返回 false 。
+
+    \note  上个数据块未取完的数据，将复制到内部缓存。
+  */
+  xbin_splitter& feed(const void* const p, const size_t n) {
+    drop();
+    if (_pos < _len) _buf.append(_chunk + _pos, _len - _pos);
+    _chunk = (const uint8_t*)p;
+    _len = n;
+    _pos = 0;
+    return *this;
+  }
+  /// 取出下一个完整数据帧（不含数据头）。数据不足或出错时返回 false 。
+  bool next(reader_type& frame) {
+    if (_bad) return false;
+    drop();
+
+    if (!_buf.empty()) {
+      // 先补齐缓存中的数据帧。数据头不完整时，逐 byte 补入。
+      size_t hlen;
+      size_t blen;
+      while (0 == (hlen = head(_buf.data(), _buf.size(), blen))) {
+        if (_pos >= _len) return false;
+        _buf.push_back(_chunk[_pos++]);
+      }
+      if (SIZE_MAX == hlen) return fail();
+
+      const size_t flen = hlen + blen;
+      if (_buf.size() < flen) {
+        const size_t n = std::min(flen - _buf.size(), _len - _pos);
+        _buf.append(_chunk + _pos, n);
+        _pos += n;
+        if (_buf.size() < flen) return false;
+      }
+      frame = reader_type(_buf.data() + hlen, blen);
+      _used = flen;
+      return true;
+    }
+
+    const auto p = _chunk + _pos;
+    const size_t remain = _len - _pos;
+    if (0 == remain) return false;
+
+    size_t blen;
+    const size_t hlen = head(p, remain, blen);
+    if (SIZE_MAX == hlen) return fail();
+    if (0 != hlen && blen <= remain - hlen) {
+      frame = reader_type(p + hlen, blen);
+      _pos += hlen + blen;
+      return true;
+    }
+    // 数据帧不完整，缓存剩余数据。
+    _buf.assign(p, remain);
+    _pos = _len;
+    return false;
+  }
+  /**
+    将当前数据块未取出的数据复制到内部缓存，之后数据块可释放或复用。
+
+    \note  之前 next 返回的数据块视图不受影响，内部缓存的视图失效。
+  */
+  xbin_splitter& hold() { return feed(nullptr, 0); }
+  /// 是否出错。
+  bool bad() const { return _bad; }
+  /// 缓存中未成帧的数据大小。
+  size_t buffered() const { return _buf.size() - _used + (_len - _pos); }
+  void reset() {
+    _buf.clear();
+    _used = 0;
+    _chunk = nullptr;
+    _len = 0;
+    _pos = 0;
+    _bad = false;
+  }
+
+ private:
+  /**
+    解析数据头。
+    \return  数据头长度。数据头不完整返回 0 ，出错返回 SIZE_MAX 。
+  */
+  size_t head(const uint8_t* const p, const size_t n, size_t& blen) const {
+    if constexpr (!std::is_void_v<headtype>) {
+      if (n < sizeof(headtype)) return 0;
+      headtype xlen;
+      memcpy(&xlen, p, sizeof(xlen));
+      blen = (headtype)(bigendian ? bswap(xlen) : xlen);
+      if constexpr (headself) {
+        if (blen < sizeof(headtype)) return SIZE_MAX;
+        blen -= sizeof(headtype);
+      }
+      if (blen > _max_frame) return SIZE_MAX;
+      return sizeof(headtype);
+    } else {
+      const size_t hlen = xvarint_decode(blen, p, p + n);
+      if (0 == hlen) return (n < xvarint_max<size_t>) ? 0 : SIZE_MAX;
+      if (blen > _max_frame) return SIZE_MAX;
+      return hlen;
+    }
+  }
+  /// 丢弃上次返回的缓存数据帧。
+  void drop() {
+    if (0 == _used) return;
+    _buf.erase(0, _used);
+    _used = 0;
+  }
+  bool fail() {
+    _bad = true;
+    return false;
+  }
+
+ private:
+  size_t          _max_frame;
+  std::basic_string<uint8_t, std::char_traits<uint8_t>, alloc> _buf;
+  size_t          _used = 0;          //< 缓存中已返回的数据帧大小。
+  const uint8_t*  _chunk = nullptr;   //< 当前数据块。
+  size_t          _len = 0;
+  size_t          _pos = 0;
+  bool            _bad = false;
 };
 
 /// lbin 数据头为 word ，不包含自身，小端序，不处理结尾 0 。
@@ -363,6 +1555,27 @@ using gbin = xbin<uint16_t, false, true, true>;
 /// vbin 为 xvarint 格式，忽略后继所有设置。
 using vbin = xbin<void, false, false, false>;
 
+/// 与 lbin 对应的只读视图。
+using lbin_view = xbin_reader<uint16_t, false, false, false>;
+/// 与 gbin 对应的只读视图。
+using gbin_view = xbin_reader<uint16_t, false, true, true>;
+/// 与 vbin 对应的只读视图。
+using vbin_view = xbin_reader<void, false, false, false>;
+
+/// 与 lbin 对应的分段组织。
+using lbin_sg = xbin_sg<uint16_t, false, false, false>;
+/// 与 gbin 对应的分段组织。
+using gbin_sg = xbin_sg<uint16_t, false, true, true>;
+/// 与 vbin 对应的分段组织。
+using vbin_sg = xbin_sg<void, false, false, false>;
+
+/// 与 lbin 对应的数据帧分离。
+using lbin_splitter = xbin_splitter<uint16_t, false, false, false>;
+/// 与 gbin 对应的数据帧分离。
+using gbin_splitter = xbin_splitter<uint16_t, false, true, true>;
+/// 与 vbin 对应的数据帧分离。
+using vbin_splitter = xbin_splitter<void, false, false, false>;
+
 }  // namespace xlib
 
 #endif  // _XLIB_XBIN_H_
\ No newline at end of file
@@ -1,5 +1,10 @@
 ﻿#include "xcrc.h"
 
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
 #include "xlib_test.h"
 
 SHOW_TEST_INIT(xcrc)
@@ -43,4 +48,253 @@ done = (c0 == 0x261DAEE5) &&
        (c2 == 0xC57A);
 SHOW_TEST_RESULT;
 
+SHOW_TEST_HEAD(constexpr data);
+{
+  enum class E : uint8_t { A = '1', B = '2' };
+  static constexpr uint16_t table[] = {0x3231, 0x3433, 0x3635};
+  static constexpr E es[] = {E::A, E::B};
+  constexpr std::string_view sv("123456789\0abc", 13);
+  constexpr auto c0 = xlib::crc32(sv.substr(0, 9));
+  constexpr auto c1 = xlib::crc32(sv);
+  constexpr auto c2 = xlib::crc16(std::span(table).first(2));
+  constexpr auto c3 = xlib::crc64(std::array<uint8_t, 2>{'1', '2'});
+  constexpr auto c4 = xlib::crc32c(sv.data(), 9);
+  constexpr auto c5 = xlib::crcccitt(es, 2);
+  static_assert(c0 == 0xCBF43926 && c4 == 0xE3069283);
+  // 可用于 switch 。
+  const auto name = std::string("123456789");
+  switch (xlib::crc32(name)) {
+    case xlib::crc32(std::string_view("123456789")): done = true; break;
+    default: done = false; break;
+  }
+  done = done && c1 == xlib::crc32(sv.data(), sv.size()) &&
+         c2 == xlib::crc16("1234", 4) &&
+         c3 == xlib::crc64("12") &&
+         c5 == xlib::crcccitt("12");
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(floating data);
+{
+  // 浮点数据只在运行期计算，按内存 byte 处理。
+  const float fs[] = {1.5f, -2.25f, 3.0f, 0.1f};
+  const std::vector<double> ds = {1.5, -2.25, 3.0, 0.1};
+  done = xlib::crc32(fs, 4) == xlib::crc32((const void*)fs, sizeof(fs)) &&
+         xlib::crc32(ds) ==
+             xlib::crc32((const void*)ds.data(), ds.size() * sizeof(double));
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(check);
+done = 0xBB3D == xlib::crc16("123456789", 9) &&
+       0xCBF43926 == xlib::crc32("123456789", 9) &&
+       0x995DC9BBDF1939FA == xlib::crc64("123456789", 9) &&
+       0x6F91 == xlib::crcccitt("123456789", 9) &&
+       0xE3069283 == xlib::crc32c("123456789", 9);
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(slice);
+{
+  uint8_t buf[0x200];
+  for (size_t i = 0; i < sizeof(buf); ++i) buf[i] = (uint8_t)(i * 0x9D + 7);
+  done = true;
+  for (size_t off = 0; off < 8; ++off) {
+    for (size_t len = 0; len + off <= sizeof(buf); len += 7) {
+      const auto p = buf + off;
+      done = done &&
+          xlib::XCrcByte<uint16_t, 0xA001>(0, p, len) ==
+              xlib::XCrcSlice<uint16_t, 0xA001, 8>(0, p, len) &&
+          xlib::XCrcByte<uint16_t, 0xA001>(0, p, len) ==
+              xlib::XCrcSlice<uint16_t, 0xA001, 16>(0, p, len) &&
+          xlib::XCrcByte<uint32_t, 0xEDB88320>(~0u, p, len) ==
+              xlib::XCrcSlice<uint32_t, 0xEDB88320, 8>(~0u, p, len) &&
+          xlib::XCrcByte<uint32_t, 0xEDB88320>(~0u, p, len) ==
+              xlib::XCrcSlice<uint32_t, 0xEDB88320, 16>(~0u, p, len) &&
+          xlib::XCrcByte<uint64_t, 0xC96C5795D7870F42>(~0ull, p, len) ==
+              xlib::XCrcSlice<uint64_t, 0xC96C5795D7870F42, 8>(~0ull, p, len) &&
+          xlib::XCrcByte<uint64_t, 0xC96C5795D7870F42>(~0ull, p, len) ==
+              xlib::XCrcSlice<uint64_t, 0xC96C5795D7870F42, 16>(~0ull, p, len);
+    }
+  }
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(update);
+{
+  uint8_t buf[0x400];
+  for (size_t i = 0; i < sizeof(buf); ++i) buf[i] = (uint8_t)(i * 0x9D + 7);
+  done = true;
+  for (size_t off = 0; off < 16; off += 5) {
+    for (size_t len = 0; len + off <= sizeof(buf); len += 13) {
+      const auto p = buf + off;
+      done = done &&
+          xlib::XCrcByte<uint16_t, 0xA001>(0x1234, p, len) ==
+              xlib::XCrcUpdate<uint16_t, 0xA001>(0x1234, p, len) &&
+          xlib::XCrcByte<uint32_t, 0xEDB88320>(~0u, p, len) ==
+              xlib::XCrcUpdate<uint32_t, 0xEDB88320>(~0u, p, len) &&
+          xlib::XCrcByte<uint32_t, 0x82F63B78>(~0u, p, len) ==
+              xlib::XCrcUpdate<uint32_t, 0x82F63B78>(~0u, p, len) &&
+          xlib::XCrcByte<uint64_t, 0xC96C5795D7870F42>(~0ull, p, len) ==
+              xlib::XCrcUpdate<uint64_t, 0xC96C5795D7870F42>(~0ull, p, len);
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(XCRC_NO_HW)
+      done = done && xlib::XCrcByte<uint32_t, 0x82F63B78>(~0u, p, len) ==
+                         xlib::XCrc32cHw(~0u, p, len);
+#endif
+    }
+  }
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(stream);
+{
+  std::string data(0x300, '\0');
+  for (size_t i = 0; i < data.size(); ++i) data[i] = (char)(i * 0x3B + 1);
+  done = true;
+  for (size_t step = 1; step < data.size(); step = step * 3 + 1) {
+    xlib::crc16_stream s16;
+    xlib::crc32_stream s32;
+    xlib::crc64_stream s64;
+    xlib::crcccitt_stream sct;
+    for (size_t i = 0; i < data.size(); i += step) {
+      const auto n = std::min(step, data.size() - i);
+      s16.update(data.data() + i, n);
+      s32.update(data.data() + i, n);
+      s64.update(data.data() + i, n);
+      sct.update(data.data() + i, n);
+    }
+    done = done && s16.finalize() == xlib::crc16(data) &&
+           s32.finalize() == xlib::crc32(data) &&
+           s64.finalize() == xlib::crc64(data) &&
+           sct.finalize() == xlib::crcccitt(data) &&
+           s32.size() == data.size();
+  }
+  xlib::crc32_stream s;
+  done = done && s.update(std::string("12345")).update("67890", 5).finalize() ==
+                     0x261DAEE5;
+  s.reset();
+  done = done && s.finalize() == xlib::crc32("", 0) &&
+         s.update("123456789", 9).finalize() == 0xCBF43926;
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(combine);
+{
+  std::string data(0x1000, '\0');
+  for (size_t i = 0; i < data.size(); ++i) data[i] = (char)(i * 0x3B + 1);
+  done = true;
+  for (size_t cut = 0; cut <= data.size(); cut = cut * 2 + 3) {
+    const auto a = data.data();
+    const auto b = data.data() + cut;
+    const auto n = data.size() - cut;
+    done = done &&
+        xlib::crc16_combine(xlib::crc16(a, cut), xlib::crc16(b, n), n) ==
+            xlib::crc16(data) &&
+        xlib::crc32_combine(xlib::crc32(a, cut), xlib::crc32(b, n), n) ==
+            xlib::crc32(data) &&
+        xlib::crc64_combine(xlib::crc64(a, cut), xlib::crc64(b, n), n) ==
+            xlib::crc64(data) &&
+        xlib::crcccitt_combine(xlib::crcccitt(a, cut),
+                               xlib::crcccitt(b, n), n) ==
+            xlib::crcccitt(data) &&
+        xlib::crc32c_combine(xlib::crc32c(a, cut), xlib::crc32c(b, n), n) ==
+            xlib::crc32c(data);
+  }
+  static_assert(xlib::crc32_combine(xlib::crc32("12345"), xlib::crc32("67890"),
+                                    5) == 0x261DAEE5);
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(parallel);
+{
+  std::string data(XCRC_PARALLEL_MIN * 5 + 77, '\0');
+  for (size_t i = 0; i < data.size(); ++i) data[i] = (char)(i * 0x3B + 1);
+  const auto c32 = xlib::crc32(data);
+  const auto c64 = xlib::crc64(data);
+  done = xlib::crc32_parallel(data) == c32 && xlib::crc64_parallel(data) == c64;
+  for (size_t threads = 1; threads <= 8; ++threads) {
+    done = done &&
+           xlib::crc32_parallel(data.data(), data.size(), threads) == c32 &&
+           xlib::crc64_parallel(data, threads) == c64 &&
+           xlib::crc16_parallel(data, threads) == xlib::crc16(data);
+  }
+  // 不足阈值时单线程计算。
+  done = done && xlib::crc32_parallel("123456789", 9, 4) == 0xCBF43926 &&
+         xlib::crc32_parallel(nullptr, 100) == xlib::crc32(nullptr, 100);
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(random);
+{
+  // 随机数据、长度、偏移、分块，各实现与逐 byte 查表比对。
+  std::mt19937_64 rng(0x20261019);
+  std::vector<uint8_t> buf(0x2000 + 0x40);
+  for (auto& v : buf) v = (uint8_t)rng();
+  const auto check = [&](auto ref, auto... kernels) {
+    for (size_t round = 0; round < 200; ++round) {
+      const size_t off = rng() % 0x40;
+      const size_t len = (round < 100) ? rng() % 0x100 : rng() % 0x2000;
+      const auto p = buf.data() + off;
+      const auto v = (decltype(ref(0, p, 0)))rng();
+      const auto r = ref(v, p, len);
+      if (!((r == kernels(v, p, len)) && ...)) return false;
+    }
+    return true;
+  };
+  done = check(xlib::XCrcByte<uint16_t, 0xA001>,
+               xlib::XCrcSlice<uint16_t, 0xA001, 8>,
+               xlib::XCrcSlice<uint16_t, 0xA001, 16>,
+               xlib::XCrcUpdate<uint16_t, 0xA001>) &&
+         check(xlib::XCrcByte<uint16_t, 0x8408>,
+               xlib::XCrcSlice<uint16_t, 0x8408, 8>,
+               xlib::XCrcSlice<uint16_t, 0x8408, 16>,
+               xlib::XCrcUpdate<uint16_t, 0x8408>) &&
+         check(xlib::XCrcByte<uint32_t, 0xEDB88320>,
+               xlib::XCrcSlice<uint32_t, 0xEDB88320, 8>,
+               xlib::XCrcSlice<uint32_t, 0xEDB88320, 16>,
+               xlib::XCrcUpdate<uint32_t, 0xEDB88320>) &&
+         check(xlib::XCrcByte<uint32_t, 0x82F63B78>,
+               xlib::XCrcSlice<uint32_t, 0x82F63B78, 8>,
+               xlib::XCrcSlice<uint32_t, 0x82F63B78, 16>,
+               xlib::XCrcUpdate<uint32_t, 0x82F63B78>) &&
+         check(xlib::XCrcByte<uint64_t, 0xC96C5795D7870F42>,
+               xlib::XCrcSlice<uint64_t, 0xC96C5795D7870F42, 8>,
+               xlib::XCrcSlice<uint64_t, 0xC96C5795D7870F42, 16>,
+               xlib::XCrcUpdate<uint64_t, 0xC96C5795D7870F42>);
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(XCRC_NO_HW)
+  const auto fold = [](auto byte, auto fold) {
+    return [=](auto v, const uint8_t* p, size_t len) {
+      return (len < 0x40) ? byte(v, p, len) : fold(v, p, len);
+    };
+  };
+  if (xlib::XCrcCpu(1)) {
+    done = done &&
+           check(xlib::XCrcByte<uint16_t, 0xA001>,
+                 fold(xlib::XCrcByte<uint16_t, 0xA001>,
+                      xlib::XCrcFold<uint16_t, 0xA001>)) &&
+           check(xlib::XCrcByte<uint32_t, 0xEDB88320>,
+                 fold(xlib::XCrcByte<uint32_t, 0xEDB88320>,
+                      xlib::XCrcFold<uint32_t, 0xEDB88320>)) &&
+           check(xlib::XCrcByte<uint64_t, 0xC96C5795D7870F42>,
+                 fold(xlib::XCrcByte<uint64_t, 0xC96C5795D7870F42>,
+                      xlib::XCrcFold<uint64_t, 0xC96C5795D7870F42>));
+  }
+  if (xlib::XCrcCpu(20)) {
+    done = done && check(xlib::XCrcByte<uint32_t, 0x82F63B78>,
+                         xlib::XCrc32cHw);
+  }
+#endif
+  // 随机分块的流式计算。
+  for (size_t round = 0; done && round < 50; ++round) {
+    const size_t len = rng() % buf.size();
+    xlib::crc64_stream s;
+    for (size_t i = 0; i < len;) {
+      const size_t n = std::min<size_t>(len - i, rng() % 0x200);
+      s.update(buf.data() + i, n);
+      i += n;
+    }
+    done = s.finalize() == xlib::crc64(buf.data(), len);
+  }
+}
+SHOW_TEST_RESULT;
+
 SHOW_TEST_DONE;
\ No newline at end of file
@@ -1,8 +1,8 @@
 ﻿/**
   \file  xcrc.h
-  \brief 定义了 CRC 算法模板。支持 crc16 、 crc32 、 crc64 、crcccitt 。
+  \brief 定义了 CRC 算法模板。支持 crc16 、 crc32 、 crc64 、crcccitt 、 crc32c 。
 
-  \version    3.2.1.230307
+  \version    3.7.1.261019
 
   \author     triones
   \date       2013-03-19
@@ -19,13 +19,61 @@
   - 2019-09-29 引入新特性重构，解决线程安全的问题。 3.0 。
   - 2020-03-06 引入可变参数模板，表的生成重新设计。 3.1 。
   - 2020-05-09 扩大模板匹配，匹配多数顺序容器。优化接口 3.2 。
+  - 2026-10-19 运行期计算使用 slicing-by-8/16 。 3.3 。
+  - 2026-10-19 支持 PCLMULQDQ 折叠、 SSE4.2 计算，运行期检测 CPU 。新增 crc32c 。 3.4 。
+  - 2026-10-19 新增 XCrcStream 流式计算， FUNC_combine 合并 CRC 。 3.5 。
+  - 2026-10-19 新增 FUNC_parallel 多线程计算。 3.6 。
+  - 2026-10-19 指定长度数据、顺序容器支持编译期计算。 3.7 。
+  - 2026-10-19 结尾 #undef XCRC_HW ，不再泄漏到包含者。 3.7.1 。
 */
 #ifndef _XLIB_XCRC_H_
 #define _XLIB_XCRC_H_
 
+#include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+  运行期计算每次处理的 byte 数，可选 1 、 8 、 16 。
+  - 8 需要 8 张表， 16 需要 16 张表。表在编译期生成。
+  - 编译期计算不受影响。
+*/
+#ifndef XCRC_SLICE
+#define XCRC_SLICE 8
+#endif
+static_assert(XCRC_SLICE == 1 || XCRC_SLICE == 8 || XCRC_SLICE == 16,
+              "XCRC_SLICE must be 1, 8 or 16");
+
+/**
+  多线程计算时，每个线程最少处理的 byte 数。
+  数据不足 2 倍时，直接单线程计算。
+*/
+#ifndef XCRC_PARALLEL_MIN
+#define XCRC_PARALLEL_MIN (1024 * 1024)
+#endif
+
+/**
+  x64 下运行期检测 CPU ，支持时使用 PCLMULQDQ 、 SSE4.2 计算。
+  如不需要，请在包含前 #define XCRC_NO_HW 。
+  XCRC_HW 、 XCRC_TARGET 仅在本文件内使用，结尾处 #undef 。
+*/
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(XCRC_NO_HW)
+#define XCRC_HW
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define XCRC_TARGET(x)
+#else
+#include <cpuid.h>
+#define XCRC_TARGET(x) __attribute__((target(x)))
+#endif
+#endif
 
 namespace xlib {
 
@@ -45,37 +93,374 @@ constexpr auto inline XCrcTable(std::index_sequence<I...>) noexcept {
   return std::array<T, sizeof...(I)>{XCrcTableValue<T, N>(I)...};
 }
 
+/**
+  用于编译期生成 slicing-by-S 的 S 张 CRC 表。
+  第 k 张表为单个 byte 之后再经过 k 个 0 byte 的 CRC 。
+*/
+template <typename T, T N, size_t S>
+constexpr auto inline XCrcTables() noexcept {
+  std::array<std::array<T, 0x100>, S> tables = {};
+  tables[0] = XCrcTable<T, N>(std::make_index_sequence<0x100>{});
+  for (size_t k = 1; k < S; ++k) {
+    for (size_t i = 0; i < 0x100; ++i) {
+      const T v = tables[k - 1][i];
+      tables[k][i] = (T)((v >> 8) ^ tables[0][v & 0xFF]);
+    }
+  }
+  return tables;
+}
+
+/// 编译期生成的 CRC 表，全局唯一。
+template <typename T, T N, size_t S>
+inline constexpr auto XCrcTablesV = XCrcTables<T, N, S>();
+
+/// 逐 byte 更新 CRC 。不做初值、结果取反处理。
+template <typename T, T N>
+inline T XCrcByte(T crc, const uint8_t* p, size_t size) noexcept {
+  const auto& table = XCrcTablesV<T, N, 1>[0];
+  for (; size != 0; --size, ++p) {
+    crc = (T)(table[(crc & 0xFF) ^ *p] ^ (crc >> 8));
+  }
+  return crc;
+}
+
+/**
+  slicing-by-S 更新 CRC 。不做初值、结果取反处理。
+
+  每次处理 S byte ：前 8 byte 与 CRC 异或后各自查表，后续 byte 直接查表，
+  结果异或合并。要求 CRC 位宽不超过 64 。不足 S byte 的结尾逐 byte 处理。
+*/
+template <typename T, T N, size_t S>
+inline T XCrcSlice(T crc, const uint8_t* p, size_t size) noexcept {
+  static_assert(sizeof(T) <= sizeof(uint64_t), "CRC width must be <= 64");
+  if constexpr (S >= sizeof(uint64_t)) {
+    const auto& tables = XCrcTablesV<T, N, S>;
+    for (; size >= S; size -= S, p += S) {
+      const auto c = (uint64_t)crc;
+      T ret = 0;
+      for (size_t j = 0; j < sizeof(uint64_t); ++j) {
+        ret ^= tables[S - 1 - j][p[j] ^ (uint8_t)(c >> (j * CHAR_BIT))];
+      }
+      for (size_t j = sizeof(uint64_t); j < S; ++j) {
+        ret ^= tables[S - 1 - j][p[j]];
+      }
+      crc = ret;
+    }
+  }
+  return XCrcByte<T, N>(crc, p, size);
+}
+
+#ifdef XCRC_HW
+/// 检测 CPUID.1:ECX 指定位。 1 ： PCLMULQDQ ， 20 ： SSE4.2 。
+inline bool XCrcCpu(const int bit) noexcept {
+  static const unsigned int ecx = [] {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (unsigned int)info[2];
+#else
+    unsigned int a, b, c, d;
+    return __get_cpuid(1, &a, &b, &c, &d) ? c : 0u;
+#endif
+  }();
+  return 0 != ((ecx >> bit) & 1);
+}
+
+/**
+  用于编译期计算折叠常量 rev64(x^n mod P) 。
+
+  反射域中，乘 x 即一次 CRC 移位，从 x^0 （最高位）开始移位 n 次即得。
+*/
+template <typename T, T N>
+constexpr uint64_t XCrcFoldK(const size_t n) noexcept {
+  constexpr size_t w = sizeof(T) * CHAR_BIT;
+  auto r = (T)((T)1 << (w - 1));
+  for (size_t i = 0; i < n; ++i) r = (T)((r >> 1) ^ ((r & 1) ? N : 0));
+  return (uint64_t)r << (sizeof(uint64_t) * CHAR_BIT - w);
+}
+
+/// 折叠 128 bit 。
+XCRC_TARGET("pclmul,sse2")
+inline __m128i XCrcFold128(const __m128i x, const __m128i k) noexcept {
+  return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),
+                       _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+XCRC_TARGET("sse2")
+inline __m128i XCrcLoad128(const uint8_t* const p) noexcept {
+  return _mm_loadu_si128((const __m128i*)p);
+}
+
+/**
+  PCLMULQDQ 折叠更新 CRC 。适用于位宽不超过 64 的反射 CRC 。
+
+  - 4 路并行，每次折叠 64 byte ，再合并为 1 路，余下每次折叠 16 byte 。
+  - 128 bit 数据 A 折叠 n bit 即 A.hi * (x^(n+64) mod P) ^ A.lo * (x^n mod P) ，
+    反射域的无进位乘积偏移 1 bit ，常量指数相应减 1 。
+  - 最后的 16 byte 及结尾，交由查表计算。
+  - 要求 size >= 64 。
+*/
+template <typename T, T N>
+XCRC_TARGET("pclmul,sse2")
+T XCrcFold(const T crc, const uint8_t* p, size_t size) noexcept {
+  constexpr uint64_t k191 = XCrcFoldK<T, N>(191);
+  constexpr uint64_t k127 = XCrcFoldK<T, N>(127);
+  constexpr uint64_t k575 = XCrcFoldK<T, N>(575);
+  constexpr uint64_t k511 = XCrcFoldK<T, N>(511);
+  const auto k128 = _mm_set_epi64x((int64_t)k127, (int64_t)k191);
+  const auto k512 = _mm_set_epi64x((int64_t)k511, (int64_t)k575);
+  // 初值异或到数据开头。
+  auto x0 = _mm_xor_si128(XCrcLoad128(p),
+                          _mm_cvtsi64_si128((int64_t)(uint64_t)crc));
+  auto x1 = XCrcLoad128(p + 0x10);
+  auto x2 = XCrcLoad128(p + 0x20);
+  auto x3 = XCrcLoad128(p + 0x30);
+  p += 0x40;
+  size -= 0x40;
+  for (; size >= 0x40; size -= 0x40, p += 0x40) {
+    x0 = _mm_xor_si128(XCrcFold128(x0, k512), XCrcLoad128(p));
+    x1 = _mm_xor_si128(XCrcFold128(x1, k512), XCrcLoad128(p + 0x10));
+    x2 = _mm_xor_si128(XCrcFold128(x2, k512), XCrcLoad128(p + 0x20));
+    x3 = _mm_xor_si128(XCrcFold128(x3, k512), XCrcLoad128(p + 0x30));
+  }
+  x1 = _mm_xor_si128(XCrcFold128(x0, k128), x1);
+  x2 = _mm_xor_si128(XCrcFold128(x1, k128), x2);
+  x3 = _mm_xor_si128(XCrcFold128(x2, k128), x3);
+  for (; size >= 0x10; size -= 0x10, p += 0x10) {
+    x3 = _mm_xor_si128(XCrcFold128(x3, k128), XCrcLoad128(p));
+  }
+
+  uint8_t buf[0x10];
+  _mm_storeu_si128((__m128i*)buf, x3);
+  const T ret = XCrcSlice<T, N, XCRC_SLICE>(0, buf, sizeof(buf));
+  return XCrcSlice<T, N, XCRC_SLICE>(ret, p, size);
+}
+
+/// SSE4.2 更新 crc32c 。
+XCRC_TARGET("sse4.2")
+inline uint32_t XCrc32cHw(uint32_t crc, const uint8_t* p, size_t size) noexcept {
+  uint64_t c = crc;
+  for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), p += sizeof(uint64_t)) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    c = _mm_crc32_u64(c, v);
+  }
+  crc = (uint32_t)c;
+  for (; size != 0; --size, ++p) crc = _mm_crc32_u8(crc, *p);
+  return crc;
+}
+#endif
+
+/**
+  更新 CRC 。不做初值、结果取反处理。
+
+  - 数据不少于 64 byte 且支持 PCLMULQDQ 时，使用 XCrcFold 。
+    （ 4 路折叠比单路 crc32 指令更快，crc32c 也优先使用。）
+  - crc32c 且支持 SSE4.2 时，使用 crc32 指令。
+  - 否则使用 XCrcSlice 。
+*/
+template <typename T, T N>
+inline T XCrcUpdate(const T crc, const uint8_t* const p, const size_t size) noexcept {
+#ifdef XCRC_HW
+  if (size >= 0x40 && XCrcCpu(1)) return XCrcFold<T, N>(crc, p, size);
+  if constexpr (std::is_same_v<T, uint32_t> && N == 0x82F63B78) {
+    if (XCrcCpu(20)) return XCrc32cHw(crc, p, size);
+  }
+#endif
+  return XCrcSlice<T, N, XCRC_SLICE>(crc, p, size);
+}
+
 /// CRC 计算模板。
 template <typename T, T N, T V, bool R>
 T XCRC(const void* const data, const size_t size) {
-  // 将在编译期生成 CRC 表。
-  constexpr auto CrcTable = XCrcTable<T, N>(std::make_index_sequence<0x100>{});
-  T ret = V;
   const size_t len = (nullptr == data) ? 0 : size;
-  const uint8_t* const p = (const uint8_t*)data;
-  for (size_t i = 0; i < len; ++i) {
-    ret = CrcTable[(ret & 0xFF) ^ p[i]] ^ (ret >> 8);
-  }
+  const T ret = XCrcUpdate<T, N>(V, (const uint8_t*)data, len);
   return R ? ~ret : ret;
 }
 
 /**
-  CRC 计算模板。用于 编译期计算。
+  取数组第 i 个 byte 。每个元素按 sizeof(TC) byte 小端展开。用于编译期计算。
+*/
+template <typename TC>
+constexpr uint8_t XCrcByteOf(const TC* const data, const size_t i) noexcept {
+  constexpr auto st = sizeof(TC);
+  const auto ch = data[i / st];
+  if constexpr (std::is_enum_v<TC>) {
+    return (uint8_t)((std::underlying_type_t<TC>)ch >> ((i % st) * CHAR_BIT));
+  } else {
+    return (uint8_t)(ch >> ((i % st) * CHAR_BIT));
+  }
+}
+
+/**
+  CRC 计算模板。指定类型数据，可用于编译期计算。
+  \param    size    数据长度（以相应类型字计）。
 
-  注意到，const T* const 模板无法生成 constexpr 结果。
+  - 编译期计算时，要求 TC 为整数或枚举类型，逐 byte 查表。
+  - 运行期计算时，与 XCRC(const void*, size_t) 一致。
 */
+template <typename T, T N, T V, bool R, typename TC>
+constexpr T XCrcData(const TC* const data, const size_t size) {
+  if (std::is_constant_evaluated()) {
+    if constexpr (std::is_integral_v<TC> || std::is_enum_v<TC>) {
+      const auto& table = XCrcTablesV<T, N, 1>[0];
+      const size_t len = (nullptr == data) ? 0 : size * sizeof(TC);
+      T ret = V;
+      for (size_t i = 0; i < len; ++i) {
+        ret = (T)(table[(ret & 0xFF) ^ XCrcByteOf(data, i)] ^ (ret >> 8));
+      }
+      return R ? (T)~ret : ret;
+    }
+  }
+  return XCRC<T, N, V, R>((const void*)data, size * sizeof(TC));
+}
+
+/// CRC 计算模板。用于字符串字面量，不计结尾 0 。
 template <typename TC, size_t size, typename T, T N, T V, bool R> constexpr
 T XCRC(TC const(&data)[size]) {
-  // 将在编译期生成 CRC 表。
-  constexpr auto CrcTable = XCrcTable<T, N>(std::make_index_sequence<0x100>{});
-  constexpr auto st = sizeof(TC);
-  T ret = V;
-  const size_t len = (size - 1) * st;
-  for (size_t i = 0; i < len; ++i) {
-    const auto ch = data[i / st] >> ((i % st) * CHAR_BIT);
-    ret = CrcTable[(ret & 0xFF) ^ (ch & 0xFF)] ^ (ret >> 8);
+  return XCrcData<T, N, V, R>(data, size - 1);
+}
+
+/**
+  反射域中 a * b mod P 。最高位为 x^0 。
+
+  参考 zlib 的 multmodp ，推广至任意位宽。
+*/
+template <typename T, T N>
+constexpr T XCrcMulModP(T a, T b) noexcept {
+  T m = (T)((T)1 << (sizeof(T) * CHAR_BIT - 1));
+  T p = 0;
+  for (;;) {
+    if (a & m) {
+      p ^= b;
+      if ((a & (T)(m - 1)) == 0) break;
+    }
+    m >>= 1;
+    b = (T)((b >> 1) ^ ((b & 1) ? N : 0));
+    if (m == 0) break;
   }
-  return R ? ~ret : ret;
+  return p;
+}
+
+/// 用于编译期生成 x^(2^k) mod P ， k 覆盖 size_t 的 byte 数转为 bit 数。
+template <typename T, T N>
+constexpr auto XCrcX2nTable() noexcept {
+  std::array<T, sizeof(size_t) * CHAR_BIT + 3> table = {};
+  T p = (T)((T)1 << (sizeof(T) * CHAR_BIT - 2));  // x^1
+  for (auto& v : table) {
+    v = p;
+    p = XCrcMulModP<T, N>(p, p);
+  }
+  return table;
+}
+
+template <typename T, T N>
+inline constexpr auto XCrcX2nTableV = XCrcX2nTable<T, N>();
+
+/// CRC 寄存器后接 len 个 0 byte ，即乘 x^(8 * len) mod P 。
+template <typename T, T N>
+constexpr T XCrcShift(const T crc, size_t len) noexcept {
+  const auto& table = XCrcX2nTableV<T, N>;
+  T p = (T)((T)1 << (sizeof(T) * CHAR_BIT - 1));  // x^0
+  for (size_t k = 3; len != 0; len >>= 1, ++k) {
+    if (len & 1) p = XCrcMulModP<T, N>(table[k], p);
+  }
+  return XCrcMulModP<T, N>(p, crc);
+}
+
+/**
+  合并 CRC 。已知数据 A 、 B 的 CRC ，求 A + B 的 CRC 。
+  \param    crca    数据 A 的 CRC 。
+  \param    crcb    数据 B 的 CRC 。
+  \param    lenb    数据 B 的 byte 数。
+
+  寄存器值 f(crc) = R ? ~crc : crc ，有
+  f(crcab) = shift(f(crca) ^ V, lenb) ^ f(crcb) 。
+  时间复杂度 O(log(lenb)) ，与数据无关。
+*/
+template <typename T, T N, T V, bool R>
+constexpr T XCrcCombine(const T crca, const T crcb, const size_t lenb) noexcept {
+  const T a = R ? (T)~crca : crca;
+  const T b = R ? (T)~crcb : crcb;
+  const T ret = (T)(XCrcShift<T, N>((T)(a ^ V), lenb) ^ b);
+  return R ? (T)~ret : ret;
+}
+
+/**
+  流式 CRC 计算。分块 update ，最后 finalize 取结果。
+
+  \code
+    xlib::crc32_stream s;
+    s.update("12", 2).update(std::string("34"));
+    auto x = s.finalize();    // 等同 crc32("1234", 4) 。
+  \endcode
+*/
+template <typename T, T N, T V, bool R>
+class XCrcStream {
+ public:
+  using value_type = T;
+
+ public:
+  XCrcStream& update(const void* const data, const size_t size) noexcept {
+    if (nullptr != data && 0 != size) {
+      _crc = XCrcUpdate<T, N>(_crc, (const uint8_t*)data, size);
+      _size += size;
+    }
+    return *this;
+  }
+  template <typename TT>
+  XCrcStream& update(const TT* const data, const size_t size) noexcept {
+    return update((const void*)data, size * sizeof(TT));
+  }
+  template <typename TT>
+  auto update(const TT& o) noexcept
+      -> std::enable_if_t<std::is_pointer_v<decltype(o.data())>, XCrcStream&> {
+    return update(o.data(), o.size());
+  }
+  /// 取当前结果，不影响后续 update 。
+  T finalize() const noexcept { return R ? (T)~_crc : _crc; }
+  /// 已处理的 byte 数。
+  size_t size() const noexcept { return _size; }
+  void reset() noexcept {
+    _crc = V;
+    _size = 0;
+  }
+
+ private:
+  T       _crc = V;   //< 寄存器值。
+  size_t  _size = 0;  //< 已处理 byte 数。
+};
+
+/**
+  多线程 CRC 计算模板。数据均分给各线程计算，再逐段合并。结果与 XCRC 一致。
+  \param    threads   线程数。为 0 时，使用全部硬件线程。
+*/
+template <typename T, T N, T V, bool R>
+T XCRCP(const void* const data, const size_t size, size_t threads) {
+  const size_t len = (nullptr == data) ? 0 : size;
+  if (0 == threads) threads = std::thread::hardware_concurrency();
+  threads = std::max<size_t>(1, std::min(threads, len / XCRC_PARALLEL_MIN));
+  if (threads <= 1) return XCRC<T, N, V, R>(data, len);
+
+  const auto p = (const uint8_t*)data;
+  const size_t block = len / threads;
+  std::vector<T> crcs(threads);
+  const auto routine = [&](const size_t i) {
+    const size_t n = (i + 1 == threads) ? (len - block * i) : block;
+    crcs[i] = XCRC<T, N, V, R>(p + block * i, n);
+  };
+
+  std::vector<std::thread> ths;
+  for (size_t i = 1; i < threads; ++i) ths.emplace_back(routine, i);
+  routine(0);
+  for (auto& th : ths) th.join();
+
+  T ret = crcs[0];
+  for (size_t i = 1; i < threads; ++i) {
+    const size_t n = (i + 1 == threads) ? (len - block * i) : block;
+    ret = XCrcCombine<T, N, V, R>(ret, crcs[i], n);
+  }
+  return ret;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -92,9 +477,18 @@ T XCRC(TC const(&data)[size]) {
     // 接受顺序容器。
     auto x = crc(std::string("12"));
     auto x = crc(std::array<char, 1>{'1'});
-    // 接受字符串字面量。
+    // 接受字符串字面量。不计结尾 0 。
     auto x = crc("12");
     auto x = crc(L"12");
+    // 以上均可编译期计算。
+    constexpr auto x = crc(std::string_view("12"));
+    constexpr auto x = crc(std::span(table).first(n));
+    // 流式计算，合并 CRC 。
+    crc_stream s;
+    auto x = s.update("12", 2).finalize();
+    auto x = crc_combine(crc("1", 1), crc("2", 1), 1);
+    // 多线程计算大块数据。
+    auto x = crc_parallel(p, size);
   \endcode
 */
 #define CRCX(FUNC, TT, NN, VV, RR)                                    \
@@ -102,26 +496,46 @@ T XCRC(TC const(&data)[size]) {
     return XCRC<TT, NN, VV, RR>(data, size);                          \
   }                                                                   \
   template <typename T>                                               \
-  inline auto FUNC(const T* const data, const size_t size) {          \
-    return FUNC((const void*)data, size * sizeof(T));                 \
+  constexpr auto FUNC(const T* const data, const size_t size) {       \
+    return XCrcData<TT, NN, VV, RR>(data, size);                      \
   }                                                                   \
   template <typename T>                                               \
-  inline auto FUNC(const T& o)                                        \
+  constexpr auto FUNC(const T& o)                                     \
       ->std::enable_if_t<std::is_pointer_v<decltype(o.data())>, TT> { \
     return FUNC(o.data(), o.size());                                  \
   }                                                                   \
   template <typename T, size_t size> constexpr                        \
   inline auto FUNC(T const(&data)[size]) {                            \
     return XCRC<T, size, TT, NN, VV, RR>(data);                       \
+  }                                                                   \
+  using FUNC##_stream = XCrcStream<TT, NN, VV, RR>;                   \
+  constexpr TT FUNC##_combine(const TT a, const TT b, size_t n) {     \
+    return XCrcCombine<TT, NN, VV, RR>(a, b, n);                      \
+  }                                                                   \
+  inline auto FUNC##_parallel(const void* const data, const size_t size, \
+                              const size_t threads = 0) {             \
+    return XCRCP<TT, NN, VV, RR>(data, size, threads);                \
+  }                                                                   \
+  template <typename T>                                               \
+  inline auto FUNC##_parallel(const T& o, const size_t threads = 0)   \
+      ->std::enable_if_t<std::is_pointer_v<decltype(o.data())>, TT> { \
+    return FUNC##_parallel(o.data(), o.size() * sizeof(*o.data()),    \
+                           threads);                                  \
   }
 
 CRCX(crc16,     uint16_t, 0xA001, 0, false);
 CRCX(crc32,     uint32_t, 0xEDB88320, 0xFFFFFFFF, true);
 CRCX(crc64,     uint64_t, 0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF, true);
 CRCX(crcccitt,  uint16_t, 0x8408, 0xFFFF, false);
+CRCX(crc32c,    uint32_t, 0x82F63B78, 0xFFFFFFFF, true);
 
 #undef CRCX
 
 }  // namespace xlib
 
+#ifdef XCRC_HW
+#undef XCRC_HW
+#undef XCRC_TARGET
+#endif
+
 #endif  // _XLIB_XCRC_H_
\ No newline at end of file
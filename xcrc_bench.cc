@@ -0,0 +1,130 @@
+﻿/**
+  xcrc 各实现的吞吐量测试。不参与 test.exe ，单独编译运行。
+
+  make -f Makefile.gcc bench
+  xcrc_bench [最大数据长度]     // 默认 1 GB 。
+
+  按 CRC 类型、实现、数据长度（ 16 B 起，每次 x4 ）、起始偏移输出 GB/s 。
+  运行前先与逐 byte 查表结果比对，不一致的实现标记为 FAIL 。
+*/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "xcrc.h"
+
+namespace {
+
+template <typename T>
+using Kernel = T (*)(T, const uint8_t*, size_t);
+
+template <typename T>
+struct KernelInfo {
+  const char*   name;
+  Kernel<T>     kernel;
+  size_t        min_size;   //< 要求的最小数据长度。
+};
+
+constexpr size_t kOffsets[] = {0, 1, 3};
+
+volatile uint64_t g_sink = 0;   //< 防止计算被优化掉。
+
+/// 重复计算至少 0.1 s ，返回 GB/s 。
+template <typename T>
+double measure(const Kernel<T> kernel, const uint8_t* p, const size_t size) {
+  using clock = std::chrono::steady_clock;
+  const double min_time = 0.1;
+  size_t loops = 1;
+  T sink = 0;
+  for (;;) {
+    const auto beg = clock::now();
+    for (size_t i = 0; i < loops; ++i) sink ^= kernel(sink, p, size);
+    const std::chrono::duration<double> used = clock::now() - beg;
+    if (used.count() >= min_time || loops >= ((size_t)1 << 40)) {
+      g_sink = g_sink + sink;
+      return (double)size * loops / used.count() / 1e9;
+    }
+    loops *= (used.count() > 0.001) ? (size_t)(min_time / used.count()) + 1 : 8;
+  }
+}
+
+template <typename T, T N>
+void bench(const char* const name,
+           const uint8_t* const buf,
+           const size_t max_size) {
+  std::vector<KernelInfo<T>> kernels = {
+      {"byte",    &xlib::XCrcByte<T, N>,        0},
+      {"slice8",  &xlib::XCrcSlice<T, N, 8>,    0},
+      {"slice16", &xlib::XCrcSlice<T, N, 16>,   0},
+  };
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(XCRC_NO_HW)
+  if (xlib::XCrcCpu(1)) {
+    kernels.push_back({"fold", &xlib::XCrcFold<T, N>, 0x40});
+  }
+  if constexpr (std::is_same_v<T, uint32_t> && N == 0x82F63B78) {
+    if (xlib::XCrcCpu(20)) kernels.push_back({"sse4.2", &xlib::XCrc32cHw, 0});
+  }
+#endif
+  kernels.push_back({"update", &xlib::XCrcUpdate<T, N>, 0});
+
+  printf("\n==== %s\n%-8s %12s", name, "kernel", "size");
+  for (const auto off : kOffsets) printf("   off %zu", off);
+  printf("\n");
+
+  for (const auto& k : kernels) {
+    // 先校验，避免测出错误实现的速度。
+    const size_t check = std::min<size_t>(max_size, 0x1000) - 1;
+    const bool ok = check < k.min_size ||
+                    k.kernel((T)~0, buf + 1, check) ==
+                        xlib::XCrcByte<T, N>((T)~0, buf + 1, check);
+    if (!ok) {
+      printf("%-8s FAIL\n", k.name);
+      continue;
+    }
+    for (size_t size = 16; size <= max_size; size *= 4) {
+      if (size < k.min_size) continue;
+      printf("%-8s %12zu", k.name, size);
+      for (const auto off : kOffsets) {
+        printf(" %7.2f", measure(k.kernel, buf + off, size));
+      }
+      printf("\n");
+      fflush(stdout);
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  size_t max_size = (size_t)1 << 30;
+  if (argc > 1) {
+    max_size = std::max<size_t>(16, strtoull(argv[1], nullptr, 0));
+  }
+
+  const size_t len = max_size + 0x40;
+  std::unique_ptr<uint8_t[]> buf(new uint8_t[len]);
+  uint64_t x = 0x9E3779B97F4A7C15;
+  for (size_t i = 0; i < len; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    buf[i] = (uint8_t)x;
+  }
+  // 按 64 byte 对齐，保证 off 0 即对齐。
+  const auto p = buf.get() + ((0x40 - ((uintptr_t)buf.get() & 0x3F)) & 0x3F);
+
+  printf("xcrc bench , GB/s , XCRC_SLICE = %d", XCRC_SLICE);
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(XCRC_NO_HW)
+  printf(" , pclmul = %d , sse4.2 = %d", xlib::XCrcCpu(1), xlib::XCrcCpu(20));
+#endif
+  printf("\n");
+
+  bench<uint16_t, 0xA001>("crc16", p, max_size);
+  bench<uint32_t, 0xEDB88320>("crc32", p, max_size);
+  bench<uint64_t, 0xC96C5795D7870F42>("crc64", p, max_size);
+  bench<uint16_t, 0x8408>("crcccitt", p, max_size);
+  bench<uint32_t, 0x82F63B78>("crc32c", p, max_size);
+  return 0;
+}
@@ -0,0 +1,103 @@
+﻿#include "xhash.h"
+
+#include <array>
+#include <climits>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "xlib_test.h"
+
+SHOW_TEST_INIT(xhash)
+
+SHOW_TEST_HEAD(xhash);
+done = 0x93228A4DE0EEC5A2 == xlib::xhash(0, "", 0) &&
+       0xC5BAC3DB178713C4 == xlib::xhash(1, "a", 1) &&
+       0xA97F2F7B1D9B3314 == xlib::xhash(2, "abc", 3) &&
+       0x786D1F1DF3801DF4 == xlib::xhash(3, "message digest", 14) &&
+       0xDCA5A8138AD37C87 == xlib::xhash(4, "abcdefghijklmnopqrstuvwxyz", 26) &&
+       0xB9E734F117CFAF70 == xlib::xhash(5, std::string(
+           "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789")) &&
+       0x6CC5EAB49A92D617 == xlib::xhash(6, std::string(
+           "1234567890123456789012345678901234567890"
+           "1234567890123456789012345678901234567890"));
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(overload);
+const auto h = xlib::xhash("1234567890", 10);
+done = h == xlib::xhash((      void*)"1234567890", 10) &&
+       h == xlib::xhash((const void*)"1234567890", 10) &&
+       h == xlib::xhash((      char*)"1234567890", 10) &&
+       h == xlib::xhash(std::string("1234567890")) &&
+       h == xlib::xhash(std::array<char, 10>{'1', '2', '3', '4', '5',
+                                             '6', '7', '8', '9', '0'}) &&
+       h == xlib::xhash("1234567890") &&
+       h == xlib::xhash(0, "1234567890") &&
+       h != xlib::xhash(1, "1234567890") &&
+       xlib::xhash(u"12", 2) == xlib::xhash("1\0" "2\0", 4) &&
+       xlib::xhash(nullptr, 10) == xlib::xhash("", 0);
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(constexpr);
+{
+  std::string data(0x100, '\0');
+  for (size_t i = 0; i < data.size(); ++i) data[i] = (char)('a' + i % 26);
+  constexpr auto c0 = xlib::xhash("1234567890");
+  constexpr auto c1 = xlib::xhash(
+      7, u8"abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz");
+  constexpr auto c2 = xlib::xhash(u"12");
+  done = c0 == xlib::xhash("1234567890", 10) &&
+         c1 == xlib::xhash(7, data.data(), 52) &&
+         c2 == xlib::xhash(u"12", 2);
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(constexpr data);
+{
+  static constexpr uint16_t table[] = {0x3231, 0x3433, 0x3635};
+  constexpr std::string_view sv("123456\0abc", 10);
+  constexpr auto c0 = xlib::xhash(sv);
+  constexpr auto c1 = xlib::xhash(sv.substr(0, 6));
+  constexpr auto c2 = xlib::xhash(9, std::span(table).first(2));
+  constexpr auto c3 = xlib::xhash(std::array<uint8_t, 3>{'1', '2', '3'});
+  done = c0 == xlib::xhash(sv.data(), sv.size()) &&
+         c1 == xlib::xhash("123456") &&
+         c2 == xlib::xhash(9, "1234", 4) &&
+         c3 == xlib::xhash("123");
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(floating data);
+{
+  // 浮点数据只在运行期计算，按内存 byte 处理。
+  const float fs[] = {1.5f, -2.25f, 3.0f, 0.1f};
+  const std::vector<double> ds = {1.5, -2.25, 3.0, 0.1};
+  done = xlib::xhash(fs, 4) == xlib::xhash((const void*)fs, sizeof(fs)) &&
+         xlib::xhash(ds) ==
+             xlib::xhash((const void*)ds.data(), ds.size() * sizeof(double));
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(distribution);
+{
+  // 所有长度分支、逐 bit 翻转均无碰撞。
+  uint8_t buf[0x80] = {};
+  std::set<uint64_t> hs;
+  size_t count = 0;
+  for (size_t len = 0; len <= sizeof(buf); ++len) {
+    hs.insert(xlib::xhash(buf, len));
+    ++count;
+    for (size_t i = 0; i < len * CHAR_BIT; i += 3) {
+      buf[i / CHAR_BIT] ^= (uint8_t)(1 << (i % CHAR_BIT));
+      hs.insert(xlib::xhash(buf, len));
+      buf[i / CHAR_BIT] ^= (uint8_t)(1 << (i % CHAR_BIT));
+      ++count;
+    }
+  }
+  done = hs.size() == count;
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_DONE;
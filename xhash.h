@@ -0,0 +1,244 @@
+﻿/**
+  \file  xhash.h
+  \brief 定义了快速的 64 bit 非加密 hash 算法。用于 hash 表、去重等场景。
+
+  \version    1.1.0.261019
+
+  \author     triones
+  \date       2026-10-19
+
+  \section history 版本记录
+
+  - 2026-10-19 新建 xhash 模块。算法与 wyhash （ final version 4 ）一致。 1.0 。
+  - 2026-10-19 指定长度数据、顺序容器支持编译期计算。 1.1 。
+*/
+#ifndef _XLIB_XHASH_H_
+#define _XLIB_XHASH_H_
+
+#include <bit>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if !defined(__SIZEOF_INT128__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace xlib {
+
+/// 默认密钥，与 wyhash 一致。
+inline constexpr uint64_t XHashSecret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+/// 64 bit * 64 bit = 128 bit ，低位存 a ，高位存 b 。
+constexpr void XHashMum(uint64_t& a, uint64_t& b) noexcept {
+#ifdef __SIZEOF_INT128__
+  const auto r = (unsigned __int128)a * b;
+  a = (uint64_t)r;
+  b = (uint64_t)(r >> 64);
+#else
+#ifdef _M_X64
+  if (!std::is_constant_evaluated()) {
+    a = _umul128(a, b, &b);
+    return;
+  }
+#endif
+  const uint64_t ha = a >> 32, hb = b >> 32;
+  const uint64_t la = (uint32_t)a, lb = (uint32_t)b;
+  const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  const uint64_t t = rl + (rm0 << 32);
+  const uint64_t lo = t + (rm1 << 32);
+  const uint64_t c = (uint64_t)(t < rl) + (uint64_t)(lo < t);
+  a = lo;
+  b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+constexpr uint64_t XHashMix(uint64_t a, uint64_t b) noexcept {
+  XHashMum(a, b);
+  return a ^ b;
+}
+
+/// 运行期读取数据。按小端读取。
+class XHashPtrReader {
+ public:
+  explicit XHashPtrReader(const void* const data) noexcept
+      : _p((const uint8_t*)data) {}
+  uint64_t r1(const size_t i) const noexcept { return _p[i]; }
+  uint64_t r4(const size_t i) const noexcept {
+    uint32_t v;
+    memcpy(&v, _p + i, sizeof(v));
+    if constexpr (std::endian::native == std::endian::big) {
+      v = (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+    }
+    return v;
+  }
+  uint64_t r8(const size_t i) const noexcept {
+    if constexpr (std::endian::native == std::endian::big) {
+      return r4(i) | (r4(i + 4) << 32);
+    }
+    uint64_t v;
+    memcpy(&v, _p + i, sizeof(v));
+    return v;
+  }
+
+ private:
+  const uint8_t* _p;
+};
+
+/**
+  编译期读取数组数据。
+
+  每个元素按 sizeof(TC) byte 小端展开，与 XCRC 编译期计算一致。
+*/
+template <typename TC>
+class XHashArrayReader {
+ public:
+  constexpr explicit XHashArrayReader(const TC* const data) noexcept
+      : _data(data) {}
+  constexpr uint64_t r1(const size_t i) const noexcept {
+    constexpr auto st = sizeof(TC);
+    const auto ch = _data[i / st];
+    if constexpr (std::is_enum_v<TC>) {
+      using U = std::underlying_type_t<TC>;
+      return (uint8_t)((U)ch >> ((i % st) * CHAR_BIT));
+    } else {
+      return (uint8_t)(ch >> ((i % st) * CHAR_BIT));
+    }
+  }
+  constexpr uint64_t r4(const size_t i) const noexcept {
+    return r1(i) | (r1(i + 1) << 8) | (r1(i + 2) << 16) | (r1(i + 3) << 24);
+  }
+  constexpr uint64_t r8(const size_t i) const noexcept {
+    return r4(i) | (r4(i + 4) << 32);
+  }
+
+ private:
+  const TC* _data;
+};
+
+/**
+  hash 计算模板。 R 提供 r1 、 r4 、 r8 ，读取指定偏移的 1 、 4 、 8 byte 。
+
+  - 不超过 16 byte 时，读取首尾重叠的数据，无分支循环。
+  - 超过 48 byte 时，3 路并行，每次处理 48 byte 。
+  - 余下每次处理 16 byte ，最后 16 byte 与结尾重叠读取。
+*/
+template <typename R>
+constexpr uint64_t XHASH(const R& r, const size_t len, uint64_t seed) noexcept {
+  const auto& s = XHashSecret;
+  seed ^= XHashMix(seed ^ s[0], s[1]);
+  uint64_t a = 0, b = 0;
+  if (len <= 16) {
+    if (len >= 4) {
+      const size_t m = (len >> 3) << 2;
+      a = (r.r4(0) << 32) | r.r4(m);
+      b = (r.r4(len - 4) << 32) | r.r4(len - 4 - m);
+    } else if (len > 0) {
+      a = (r.r1(0) << 16) | (r.r1(len >> 1) << 8) | r.r1(len - 1);
+    }
+  } else {
+    size_t i = len;
+    size_t p = 0;
+    if (i > 48) {
+      uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = XHashMix(r.r8(p) ^ s[1], r.r8(p + 8) ^ seed);
+        see1 = XHashMix(r.r8(p + 16) ^ s[2], r.r8(p + 24) ^ see1);
+        see2 = XHashMix(r.r8(p + 32) ^ s[3], r.r8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    for (; i > 16; i -= 16, p += 16) {
+      seed = XHashMix(r.r8(p) ^ s[1], r.r8(p + 8) ^ seed);
+    }
+    a = r.r8(p + i - 16);
+    b = r.r8(p + i - 8);
+  }
+  a ^= s[1];
+  b ^= seed;
+  XHashMum(a, b);
+  return XHashMix(a ^ s[0] ^ len, b ^ s[1]);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/**
+  生成指定数据的 hash 。重载与 crc 一致，带 seed 的版本 seed 前置。
+  \param    seed    指定 seed ，默认为 0 。
+  \param    data    指定需要计算 hash 的数据。
+  \param    size    指定需要计算 hash 的数据长度（以相应类型字计）。
+  \return           返回 64 bit hash 值。
+
+  \code
+    // 接受指定长度数据。
+    auto x = xhash((void*)"12", 2);
+    auto x = xhash(L"12", 2);
+    // 接受顺序容器。
+    auto x = xhash(std::string("12"));
+    // 接受字符串字面量。不计结尾 0 。
+    auto x = xhash("12");
+    // 除 void* 外，均可编译期计算。
+    constexpr auto x = xhash(std::string_view("12"));
+    // 指定 seed 。
+    auto x = xhash(seed, "12", 2);
+    auto x = xhash(seed, std::string("12"));
+  \endcode
+*/
+inline uint64_t xhash(const uint64_t seed,
+                      const void* const data,
+                      const size_t size) noexcept {
+  const size_t len = (nullptr == data) ? 0 : size;
+  return XHASH(XHashPtrReader(data), len, seed);
+}
+
+template <typename T>
+constexpr uint64_t xhash(const uint64_t seed,
+                         const T* const data,
+                         const size_t size) noexcept {
+  if (std::is_constant_evaluated()) {
+    if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+      const size_t len = (nullptr == data) ? 0 : size * sizeof(T);
+      return XHASH(XHashArrayReader<T>(data), len, seed);
+    }
+  }
+  return xhash(seed, (const void*)data, size * sizeof(T));
+}
+
+template <typename T>
+constexpr auto xhash(const uint64_t seed, const T& o) noexcept
+    -> std::enable_if_t<std::is_pointer_v<decltype(o.data())>, uint64_t> {
+  return xhash(seed, o.data(), o.size());
+}
+
+template <typename T, size_t size>
+constexpr uint64_t xhash(const uint64_t seed, T const (&data)[size]) noexcept {
+  return xhash(seed, (const T*)data, size - 1);
+}
+
+inline uint64_t xhash(const void* const data, const size_t size) noexcept {
+  return xhash(0, data, size);
+}
+
+template <typename T>
+constexpr uint64_t xhash(const T* const data, const size_t size) noexcept {
+  return xhash(0, data, size);
+}
+
+template <typename T>
+constexpr auto xhash(const T& o) noexcept
+    -> std::enable_if_t<std::is_pointer_v<decltype(o.data())>, uint64_t> {
+  return xhash(0, o);
+}
+
+template <typename T, size_t size>
+constexpr uint64_t xhash(T const (&data)[size]) noexcept {
+  return xhash(0, data);
+}
+
+}  // namespace xlib
+
+#endif  // _XLIB_XHASH_H_
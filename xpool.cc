@@ -0,0 +1,82 @@
+﻿#include "xpool.h"
+
+#include <atomic>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "xbin.h"
+#include "xlib_test.h"
+
+SHOW_TEST_INIT(xpool)
+
+SHOW_TEST_HEAD(alloc free);
+auto pa = xlib::xpool::alloc(0x18);
+xlib::xpool::free(pa, 0x18);
+auto pb = xlib::xpool::alloc(0x20);
+auto pc = xlib::xpool::alloc(0x20);
+done = pa == pb && pb != pc;
+xlib::xpool::free(pb, 0x20);
+xlib::xpool::free(pc, 0x20);
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(alloc large);
+pa = xlib::xpool::alloc(xlib::xpool::max_size + 1);
+memset(pa, 0, xlib::xpool::max_size + 1);
+xlib::xpool::free(pa, xlib::xpool::max_size + 1);
+done = true;
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xpool_allocator);
+std::vector<int, xlib::xpool_allocator<int>> vec;
+for (int i = 0; i < 0x1000; ++i) vec.push_back(i);
+done = vec.size() == 0x1000 && vec[0x345] == 0x345;
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xbin xpool_allocator);
+xlib::xbin<uint16_t, false, true, true, xlib::xpool_allocator<uint8_t>> pbin, pbins;
+pbin << (uint32_t)0x12345678 << "123456";
+pbins << pbin;
+uint16_t plen = 0;
+uint32_t pv = 0;
+xlib::xbin_reader preader(pbins);
+preader >> plen >> pv;
+done = plen == 11 && pv == 0x12345678 && preader.remain() == 7;
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(after cache destroyed);
+// 线程缓存析构后，仍在使用的 thread_local 容器析构、再申请。
+std::atomic<bool> pok = false;
+std::thread([&pok] {
+  struct Late {
+    std::vector<int, xlib::xpool_allocator<int>> v;
+    std::atomic<bool>* ok = nullptr;
+    ~Late() {
+      v.clear();
+      v.shrink_to_fit();
+      auto p = xlib::xpool::alloc(0x20);
+      xlib::xpool::free(p, 0x20);
+      if (nullptr != ok) *ok = nullptr != p;
+    }
+  };
+  // 先于线程缓存构造，后于其析构。
+  thread_local Late late;
+  late.ok = &pok;
+  late.v.assign(0x10, 1);
+}).join();
+// static 容器在进程退出时析构，此时主线程缓存已析构。
+static std::vector<int, xlib::xpool_allocator<int>> svec(0x10, 1);
+done = pok && svec.size() == 0x10;
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xbin pmr);
+uint8_t pmrbuf[0x100];
+std::pmr::monotonic_buffer_resource mbr(pmrbuf, sizeof(pmrbuf));
+xlib::xbin<void, false, false, false, std::pmr::polymorphic_allocator<uint8_t>>
+    mbin{std::pmr::polymorphic_allocator<uint8_t>(&mbr)};
+mbin << (uint32_t)0x12345678 << std::string(0x40, 'x');
+done = mbin.data() >= pmrbuf && mbin.data() < pmrbuf + sizeof(pmrbuf) &&
+       mbin.size() == 5 + 0x40;
+SHOW_TEST_RESULT;
+
+SHOW_TEST_DONE;
\ No newline at end of file
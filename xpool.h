@@ -0,0 +1,142 @@
+﻿/**
+  \file  xpool.h
+  \brief 定义了线程局部的分级内存池及其分配器。
+
+  \version    0.1.1.261019
+
+  \author     triones
+  \date       2026-10-19
+
+  \details
+
+  - 小块内存按大小分级，释放后缓存在当前线程，再次申请时直接复用。
+  - 缓存无需加锁。跨线程释放的内存，进入释放线程的缓存。
+  - 超出分级上限的内存，直接使用 operator new 。
+  - 每级缓存有数量上限，超出时直接释放。
+  - 线程退出时释放缓存。此后该线程的申请、释放（如 static 容器的析构）
+    直接使用 operator new 、 operator delete 。
+
+  \section history 版本记录
+
+  - 2026-10-19 新建 xpool 。 0.1 。
+  - 2026-10-19 线程缓存析构后，回退为直接申请、释放。 0.1.1 。
+*/
+#ifndef _XLIB_XPOOL_H_
+#define _XLIB_XPOOL_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace xlib {
+
+class xpool {
+ public:
+  /// 最小分级大小。
+  static inline constexpr size_t min_size = 0x10;
+  /// 分级数量。分级大小为 0x10 、 0x20 …… 0x1000 。
+  static inline constexpr size_t classes = 9;
+  /// 最大分级大小。
+  static inline constexpr size_t max_size = min_size << (classes - 1);
+  /// 每级缓存数量上限。
+  static inline constexpr size_t max_count = 0x40;
+
+ public:
+  /// 申请内存。
+  static void* alloc(const size_t size) {
+    const auto i = index(size);
+    if (i >= classes) return ::operator new(size);
+    const auto c = cache();
+    if (nullptr == c) return ::operator new(min_size << i);
+    auto p = c->heads[i];
+    if (nullptr == p) return ::operator new(min_size << i);
+    c->heads[i] = p->next;
+    --c->counts[i];
+    return p;
+  }
+  /// 释放内存。 size 需与申请时一致。
+  static void free(void* const p, const size_t size) noexcept {
+    if (nullptr == p) return;
+    const auto i = index(size);
+    if (i >= classes) return ::operator delete(p);
+    const auto c = cache();
+    if (nullptr == c || c->counts[i] >= max_count) return ::operator delete(p);
+    const auto n = (Node*)p;
+    n->next = c->heads[i];
+    c->heads[i] = n;
+    ++c->counts[i];
+  }
+
+ private:
+  struct Node {
+    Node* next;
+  };
+  struct Cache {
+    std::array<Node*, classes>  heads = {};   //< 各级空闲链表。
+    std::array<size_t, classes> counts = {};  //< 各级缓存数量。
+    ~Cache() {
+      destroyed() = true;
+      for (auto& p : heads) {
+        while (nullptr != p) {
+          const auto n = p->next;
+          ::operator delete(p);
+          p = n;
+        }
+      }
+    }
+  };
+  /// 本线程缓存是否已析构。无析构函数，线程退出的全程可用。
+  static bool& destroyed() noexcept {
+    thread_local bool d = false;
+    return d;
+  }
+  /// 返回本线程缓存。已析构时返回 nullptr 。
+  static Cache* cache() noexcept {
+    if (destroyed()) return nullptr;
+    thread_local Cache c;
+    return &c;
+  }
+  /// 返回大小所属分级。超出分级时，返回 classes 。
+  static constexpr size_t index(const size_t size) {
+    if (size > max_size) return classes;
+    size_t i = 0;
+    while ((min_size << i) < size) ++i;
+    return i;
+  }
+};
+
+/**
+  使用 xpool 的分配器。
+
+  \code
+    using pbin = xlib::xbin<uint16_t, false, false, false,
+                            xlib::xpool_allocator<uint8_t>>;
+    std::vector<int, xlib::xpool_allocator<int>> vec;
+  \endcode
+*/
+template <typename T>
+class xpool_allocator {
+ public:
+  using value_type = T;
+
+ public:
+  xpool_allocator() noexcept = default;
+  template <typename U>
+  xpool_allocator(const xpool_allocator<U>&) noexcept {}
+  T* allocate(const size_t n) {
+    if (n > SIZE_MAX / sizeof(T)) throw std::bad_array_new_length();
+    return (T*)xpool::alloc(n * sizeof(T));
+  }
+  void deallocate(T* const p, const size_t n) noexcept {
+    xpool::free(p, n * sizeof(T));
+  }
+  template <typename U>
+  bool operator==(const xpool_allocator<U>&) const noexcept { return true; }
+  template <typename U>
+  bool operator!=(const xpool_allocator<U>&) const noexcept { return false; }
+};
+
+}  // namespace xlib
+
+#endif  // _XLIB_XPOOL_H_
\ No newline at end of file
@@ -7,8 +7,10 @@ class xxlog : public xlib::xlog {
     do_out();
   }
   virtual void raw_out(const xlib::xmsg& msg) {
-    std::cout << msg.toas() << std::endl;
+    if (!quiet) std::cout << msg.toas() << std::endl;
   }
+  /// 预期出错的测试期间不输出，以免打乱测试结果的对齐。
+  static inline bool quiet = false;
 };
 
 #define xslog xxlog()
@@ -43,6 +45,24 @@ if (done) {
 
 SHOW_TEST_RESULT;
 
+SHOW_TEST_HEAD(xsig flat report);
+
+sig = "0000<W>FC<B>000000<B a>"_sig;
+done = sig.match({xlib::xblk(ss.data(), ss.size())});
+
+if (done) {
+  xlib::xsig::FlatReports reps;
+  const auto rep = sig.report(nullptr);
+  done = sig.report(nullptr, reps) && reps.size() == 3 &&
+         reps.name(0) == "noname0" && reps.name(1) == "noname1" &&
+         reps.name(2) == "a" && reps[0].t == 'w' && reps[0].w == 0x45C7 &&
+         reps[1].t == 'b' && reps[1].b == 0x00 && reps.find("a") != nullptr &&
+         reps.find("a")->b == 0xE8 && reps.find("b") == nullptr &&
+         rep.size() == 3 && rep.at("a").b == 0xE8;
+}
+
+SHOW_TEST_RESULT;
+
 SHOW_TEST_HEAD(xsig bin);
 
 sig = "11223344..7788<W WWW>00"_sig;
@@ -54,4 +74,153 @@ done = bs.empty();
 
 SHOW_TEST_RESULT;
 
+SHOW_TEST_HEAD(xsig make_sigs);
+
+std::vector<std::string> strs;
+for (int i = 0; i < 100; ++i) strs.push_back("0000C745FC00000000E8");
+strs[37] = "0000\n  C7<X>";
+strs[64] = "0000C7\nGG";
+std::vector<xlib::xsig::Error> errs;
+auto sigs = xlib::xsig::make_sigs(strs, &errs);
+done = sigs.size() == strs.size() && errs.size() == 2 &&
+       errs[0].index == 37 && errs[0].row == 2 && errs[0].col == 6 &&
+       errs[1].index == 64 && errs[1].row == 2 && errs[1].col == 1 &&
+       !sigs[37].valid() && !sigs[64].valid() && sigs[99].valid() &&
+       sigs[99].match({xlib::xblk(ss.data(), ss.size())});
+
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xsig_trie);
+
+xlib::xsig_trie trie(xlib::xsig::make_sigs(std::vector<std::string>{
+    "0000C745FC<D>E8",      // 0
+    "0000C745E8",           // 1 不匹配。
+    "0000C7<B a>FC",        // 2
+    "..C745E8<D>",          // 3 没有前缀。
+    "0000C745FC",           // 4
+    "FF50C745E8<B b>",      // 5
+    }));
+auto ids = trie.match({xlib::xblk(ss.data(), ss.size())});
+std::sort(ids.begin(), ids.end());
+done = ids == std::vector<size_t>{0, 2, 3, 4, 5} &&
+       trie[0].report(nullptr).begin()->second.d == 0 &&
+       trie[2].report(nullptr).at("a").b == 0x45 &&
+       trie[5].report(nullptr).at("b").b == 0x00 &&
+       trie[4].report(nullptr).at("noname").p == ss.data() + 10;
+// 无效的特征码不在树中，不影响匹配。
+std::vector<xlib::xsig> tsigs(2);
+done = done && tsigs[1].make_lexs("0000C745FC");
+xlib::xsig_trie trie2(std::move(tsigs));
+done = done && !trie2[0].valid() &&
+       trie2.match({xlib::xblk(ss.data(), ss.size())}) ==
+           std::vector<size_t>{1};
+
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xsig read_sig_view);
+
+const std::string sigtext = "/\r\n  0000C745FC \n/x\n00000000E8\n/\r\n\n/\nFF50<B>\n/";
+const auto views = xlib::xsig::read_sig_view(sigtext);
+done = views.size() == 2 && views[0] == "0000C745FC \n/x\n00000000E8" &&
+       views[1] == "FF50<B>" && xlib::xsig::read_sig(sigtext).size() == 2;
+xlib::xsig sigv;
+xlib::xsig::Error errv;
+done = done && sigv.make_lexs(views[1]) &&
+       !sigv.make_lexs(std::string_view(views[1].data(), 6), errv) &&
+       errv.row == 1 && errv.col == 7;
+
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xsigs reload);
+
+const auto sigpath = std::filesystem::temp_directory_path() / "xsigs_test.sig";
+{
+  std::ofstream file(sigpath, std::ios_base::out | std::ios_base::binary);
+  file << "0000C745FC00000000E8\n/\nFF50<B>\n";
+}
+xlib::xsigs xss;
+done = xss.get() == nullptr && xss.reload_async(sigpath).get();
+const auto olds = xss.get();
+done = done && olds && olds->size() == 2;
+{
+  std::ofstream file(sigpath, std::ios_base::out | std::ios_base::binary);
+  file << "0000C745FC00000000E8\n/\nFF50<B>\n/\nE8\n";
+}
+done = done && xss.reload(sigpath) && xss.get()->size() == 3 &&
+       olds->size() == 2 &&
+       xlib::xsigs::clone(*olds)[1].match({xlib::xblk(ss.data(), ss.size())});
+{
+  std::ofstream file(sigpath, std::ios_base::out | std::ios_base::binary);
+  file << "0000C745FC00000000E8\n/\nFF50<X>\n";
+}
+xxlog::quiet = true;
+done = done && !xss.reload(sigpath) && xss.get()->size() == 3;
+xxlog::quiet = false;
+{
+  std::ofstream file(sigpath, std::ios_base::out | std::ios_base::binary);
+  file << "\xEF\xBB\xBF" << sigtext;
+}
+{
+  const xlib::xsig::SigFile sigfile(sigpath);
+  done = done && sigfile.valid() && sigfile.sigs() == views &&
+         xlib::xsig::read_sig_file(sigpath).size() == 2;
+}
+std::filesystem::remove(sigpath);
+
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xsig clone);
+
+// 同名 record 要求值相同，副本需重建其引用。
+sig = "C7<B a>FC<B b>.<B a>"_sig;
+auto sigc = sig.clone();
+const std::string ss2(xlib::hex2bin(std::string("C711FC223311C733FC440033")));
+// 原对象与副本各自匹配，互不影响。
+done = sig.match({xlib::xblk(ss2.data() + 3, ss2.size() - 3)}) &&
+       sigc.match({xlib::xblk(ss2.data(), ss2.size())}) &&
+       sig.report(nullptr).at("a").b == 0x33 &&
+       sig.report(nullptr).at("b").b == 0x44 &&
+       sigc.report(nullptr).at("a").b == 0x11 &&
+       sigc.report(nullptr).at("b").b == 0x22 &&
+       sigc.to_bin() == sig.to_bin() && !xlib::xsig().clone().valid();
+
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xsigs local);
+
+{
+  xlib::xsigs xsl;
+  xlib::xsigs::Local l0(xsl);
+  done = l0.get() == nullptr && xsl.version() == 0;
+  xsl.set(std::make_shared<xlib::xsigs::Sigs>(
+      xlib::xsig::make_sigs(std::vector<std::string>{
+          "0000C745FC<D>E8", "FF50C745E8<B b>"})));
+  // 多个扫描线程各自匹配。
+  std::atomic<size_t> hits = 0;
+  std::vector<std::thread> ths;
+  for (size_t t = 0; t < 4; ++t) {
+    ths.emplace_back([&] {
+      xlib::xsigs::Local local(xsl);
+      for (size_t i = 0; i < 100; ++i) {
+        for (auto& s : *local.get()) {
+          if (s.match({xlib::xblk(ss.data(), ss.size())}) &&
+              !s.report(nullptr).empty()) {
+            ++hits;
+          }
+        }
+      }
+    });
+  }
+  for (auto& th : ths) th.join();
+  const auto cur = l0.get();
+  done = done && hits == 4 * 100 * 2 && cur && cur->size() == 2 &&
+         l0.get() == cur;
+  // 替换后副本更新。
+  xsl.set(std::make_shared<xlib::xsigs::Sigs>(
+      xlib::xsig::make_sigs(std::vector<std::string>{"E8"})));
+  done = done && l0.get()->size() == 1 && xsl.version() == 2;
+}
+
+SHOW_TEST_RESULT;
+
 SHOW_TEST_DONE;
\ No newline at end of file
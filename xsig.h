@@ -2,7 +2,7 @@
   \file  xsig.h
   \brief 用于特征码定位。
 
-  \version    0.0.1.230208
+  \version    0.5.2.261019
 
   \author     triones
   \date       2023-02-07
@@ -20,15 +20,29 @@
   \section history 版本记录
 
   - 2023-02-07 新建 xsig 。 0.1 。
+  - 2026-10-19 新增扁平化的 FlatReports ，名称表在特征码生成时建立。 0.1.0 。
+  - 2026-10-19 新增 xsigs ，后台加载特征码文件并原子替换。 0.2.0 。
+  - 2026-10-19 新增 make_sigs ，多线程并行生成特征码组，并返回出错行列。 0.3.0 。
+  - 2026-10-19 新增 SigFile ，映射特征码文件，以 string_view 分割，无复制。 0.4.0 。
+  - 2026-10-19 新增 xsig_trie ，合并特征码组的公共前缀匹配。 0.5.0 。
+  - 2026-10-19 新增 clone 。 xsigs 发布只读特征码组，扫描线程使用各自副本匹配。 0.5.1 。
+  - 2026-10-19 以 Error 取得出错行列时，不输出解析错误。 0.5.2 。
 */
 #ifndef _XLIB_XSIG_H_
 #define _XLIB_XSIG_H_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #ifdef _WIN32
@@ -37,6 +51,11 @@
 #include <windows.h>
 #undef NOMINMAX
 #undef WIN32_LEAN_AND_MEAN
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #include "xbin.h"
@@ -68,6 +87,9 @@
   if constexpr (false) xslog
 #endif
 #define xserr xslog
+// 特征码解析错误。调用者以 Error 取得出错行列时不输出。
+#define xsperr \
+  if (!xlib::xsig::quiet_parse) xserr
 
 #ifdef _WIN32
 #ifdef _WIN64
@@ -100,30 +122,44 @@ class xsig {
   //////////////////////////////////////////////////////////////// Sign 类
   class Sign {
    public:
-    Sign(const char* const sig) : s(sig), p(0) {}
-    /// 返回当前处理的字符。
-    inline char operator()() const { return s[p]; }
+    Sign(const char* const sig) : s(sig), n(INTPTR_MAX), p(0) {}
+    /// 指定长度的特征码串，不要求以 0 结尾。
+    Sign(const std::string_view sig)
+        : s(sig.data()), n((intptr_t)sig.size()), p(0) {}
+    /// 返回当前处理的字符。越过指定长度时，返回 0 。
+    inline char operator()() const { return (p < n) ? s[p] : '\0'; }
     /// 向后移动一个字符。
     inline void operator++() { ++p; }
 
    public:
-    /// 计算当前位置行列信息，指示位置。
-    inline xmsg operator*() const {
-      intptr_t row = 1;
-      intptr_t col = 1;
+    /// 计算当前位置行列信息。越过结尾时，返回 false ，行列指示结尾。
+    inline bool pos(intptr_t& row, intptr_t& col) const {
+      row = 1;
+      col = 1;
       const intptr_t lp = p;
       for (intptr_t i = 0; i < lp; ++i) {
+        if (i >= n) return false;
         switch (s[i]) {
           case '\n': col = 1;  ++row; break;
-          case '\0': return xmsg() << "[" << row << "][" << col << "][overflow]";
+          case '\0': return false;
           default  : ++col; break;
         }
       }
+      return true;
+    }
+    /// 计算当前位置行列信息，指示位置。
+    inline xmsg operator*() const {
+      intptr_t row;
+      intptr_t col;
+      if (!pos(row, col)) {
+        return xmsg() << "[" << row << "][" << col << "][overflow]";
+      }
       return xmsg() << "[" << row << "][" << col << "]";
     }
 
    private:
     const char* s; //< 存放特征码字符串指针。
+    intptr_t    n; //< 特征码字符串长度。
     intptr_t    p; //< 指示当前解析字符起始索引。
   };
 
@@ -207,6 +243,8 @@ class xsig {
       virtual xmsg sig() const = 0;
       /// 输出词法 bin 细节。
       virtual void bin(vbin&) const = 0;
+      /// 复制结点。注意： parent 、 child 、 ref 仍指向原链，需由调用者重建。
+      virtual std::shared_ptr<Base> clone() const = 0;
       /// 输出词法 bin 。注意：默认不输出 range ，需在 bin 中自决。
       void bins(vbin& bs) const { bs << type; bin(bs); }
       /// 词法序列优化。
@@ -308,6 +346,9 @@ class xsig {
       End(vbin&) : End() {};
       virtual xmsg sig() const { return xmsg(); }
       virtual void bin(vbin&) const {}
+      virtual std::shared_ptr<Base> clone() const {
+        return std::make_shared<End>(*this);
+      }
       virtual bool test(const xblk&) const { return true; }
     };
     //////////////////////////////////////////////////////////////// 词法 dot
@@ -323,6 +364,9 @@ class xsig {
 #endif
       }
       virtual void bin(vbin& bs) const { bs << range.Min << range.Max; }
+      virtual std::shared_ptr<Base> clone() const {
+        return std::make_shared<Dot>(*this);
+      }
       virtual std::shared_ptr<Base> optimize() {
         if (!child) return std::shared_ptr<Base>();
         if (child->type != LT_Dot) return std::shared_ptr<Base>();
@@ -382,6 +426,9 @@ class xsig {
       virtual void bin(vbin& bs) const {
         bs << flag << isoff << name.size() << name;
       }
+      virtual std::shared_ptr<Base> clone() const {
+        return std::make_shared<Record>(*this);
+      }
       virtual bool test(const xblk&) const {
         // 没有需要校验的引用，直接返回 true 。
         auto lock = ref.lock();
@@ -462,6 +509,9 @@ class xsig {
 #endif
       }
       virtual void bin(vbin& bs) const { bs << str.size() << str; }
+      virtual std::shared_ptr<Base> clone() const {
+        return std::make_shared<Hexs>(*this);
+      }
       virtual std::shared_ptr<Base> optimize() {
         if (!child) return std::shared_ptr<Base>();
         if (child->type != LT_Hexs) return std::shared_ptr<Base>();
@@ -544,6 +594,9 @@ class xsig {
           bs << v.size() << v;
         }
       }
+      virtual std::shared_ptr<Base> clone() const {
+        return std::make_shared<Sets>(*this);
+      }
       virtual bool test(const xblk&) const { return true; }
 
      public:
@@ -556,6 +609,50 @@ class xsig {
  public:
   using Blks = std::vector<xblk>;
   using Reports = std::map<std::string, value>;
+  using Names = std::vector<std::string>;
+  /// 特征码生成错误信息。
+  struct Error {
+    size_t    index;  //< 出错特征码在组中的索引。
+    intptr_t  row;    //< 出错行。
+    intptr_t  col;    //< 出错列。
+  };
+  //////////////////////////////////////////////////////////////// FlatReports 类
+  /**
+    扁平化的匹配结果。
+
+    - 名称引用特征码的名称表，不复制。
+    - 值连续存放，与名称表按索引一一对应。
+    - 对象重复使用时，不再分配内存。
+  */
+  class FlatReports {
+   public:
+    size_t size() const { return _values.size(); }
+    bool empty() const { return _values.empty(); }
+    /// 返回指定索引的名称。
+    const std::string& name(const size_t i) const { return (*_names)[i]; }
+    /// 返回指定索引的值。
+    const value& operator[](const size_t i) const { return _values[i]; }
+    /// 按名称查找值，找不到返回 nullptr 。同名时返回首个。
+    const value* find(const std::string& name) const {
+      for (size_t i = 0; i < _values.size(); ++i) {
+        if ((*_names)[i] == name) return &_values[i];
+      }
+      return nullptr;
+    }
+    /// 转换为 Reports 。同名时保留首个。
+    Reports to_map() const {
+      Reports reps;
+      for (size_t i = 0; i < _values.size(); ++i) {
+        reps.insert({(*_names)[i], _values[i]});
+      }
+      return reps;
+    }
+
+   private:
+    friend class xsig;
+    std::shared_ptr<const Names>  _names;   //< 特征码的名称表。
+    std::vector<value>            _values;  //< 匹配结果值。
+  };
 
  private:
   static inline const auto gk_separation_line =
@@ -566,6 +663,25 @@ class xsig {
     _lex = o;
     if (o->parent.lock()) xserr << "add_lex has parent !";
   }
+  /// 建立 record 索引及名称表。空名依次命名为 noname0 、 noname1 ……
+  void make_index() {
+    _recs.clear();
+    auto names = std::make_shared<Names>();
+    int inoname = 0;
+    for (auto lex = _lex; lex; lex = lex->child) {
+      if (Lexical::LT_Record != lex->type) continue;
+      const auto r = (const Lexical::Record*)lex.get();
+      _recs.push_back(r);
+      if (r->name.empty()) {
+        names->push_back("noname" + std::to_string(inoname++));
+      } else {
+        names->push_back(r->name);
+      }
+    }
+    // 没有 record 时，结果为特征码起始位置。
+    if (names->empty()) names->push_back("noname");
+    _names = names;
+  }
   //////////////////////////////////////////////////////////////// 词法 hex
   ///识别函数
   /// 匹配 hex 词法，返回值 < 0 表示非此词法。
@@ -606,7 +722,7 @@ class xsig {
 
     auto Min = match_range_value(sig);
     if (Min < 0) {
-      xserr << *sig << "    range.min lost !";
+      xsperr << *sig << "    range.min lost !";
       return ErrRange;
     }
     while (isblank(sig())) ++sig;
@@ -615,7 +731,7 @@ class xsig {
       return Range(Min);
     }
     if (',' != sig()) {  // 不存在 N 值且无分隔符，非法 {} 。
-      xserr << *sig << "    range need ',' !";
+      xsperr << *sig << "    range need ',' !";
       return ErrRange;
     }
     ++sig;
@@ -624,20 +740,20 @@ class xsig {
 
     auto Max = match_range_value(sig);
     if (Min < 0) {
-      xserr << *sig << "    range.max lost !";
+      xsperr << *sig << "    range.max lost !";
       return ErrRange;
     }
 
     while (isblank(sig())) ++sig;
 
     if (sig() != '}') {
-      xserr << *sig << "  range mis '}' end/illegal char/out-max !";
+      xsperr << *sig << "  range mis '}' end/illegal char/out-max !";
       return ErrRange;
     }
     ++sig;
 
     if (Min == 0 && Max == 0) {
-      xserr << *sig << " illegal range = {0, 0} !";
+      xsperr << *sig << " illegal range = {0, 0} !";
       return ErrRange;
     }
 
@@ -711,12 +827,12 @@ class xsig {
           sets->_blks.push_back(xblk((void*)*(bs.rbegin() + 1), u));
         }
       } catch (...) {
-        xserr << *sig << " : " << v << " stoull error !";
+        xsperr << *sig << " : " << v << " stoull error !";
         return std::shared_ptr<Lexical::Sets>();
       }
     }
     if (0 != (bs.size() % 2)) {
-      xserr << *sig << " : blks no pair !";
+      xsperr << *sig << " : blks no pair !";
       return std::shared_ptr<Lexical::Sets>();
     }
     return sets;
@@ -740,7 +856,7 @@ class xsig {
       case ' ': case '\t': case '\n': case '\r': ++sig; return true;
       case '@': {
         if (_lex) {
-          xserr << pos << "@ must first character !";
+          xsperr << pos << "@ must first character !";
           return false;
         }
         ++sig;
@@ -786,12 +902,12 @@ class xsig {
           case 'W': case 'w':
           case 'B': case 'b':
             if (offset) {
-              xserr << pos << " record ^" << t << " not allow !";
+              xsperr << pos << " record ^" << t << " not allow !";
               return false;
             }
             break;
           default:
-            xserr << pos << " record need [AFQDWB] !";
+            xsperr << pos << " record need [AFQDWB] !";
             return false;
         }
         ++sig;
@@ -806,7 +922,7 @@ class xsig {
           switch (c) {
             // 不允许分行 或 突然结束。
             case '\r': case '\n': case '\0':
-              xserr << pos << " record need end by '>'";
+              xsperr << pos << " record need end by '>'";
               return false;
             // 允许嵌套。
             case lc: ++needc; name.push_back(c); ++sig; break;
@@ -857,7 +973,7 @@ class xsig {
         return true;
       }
       default:
-        xserr << *sig << " unknow lexcial !";
+        xsperr << *sig << " unknow lexcial !";
         return false;
     }
   }
@@ -874,13 +990,46 @@ class xsig {
   }
   /// 特征码串生成 特征码词法组。
   bool make_lexs(const char* const s) {
+    Sign sig(s);
+    Error err;
+    return make_lexs(sig, err);
+  }
+  /// 特征码串生成 特征码词法组。失败时， err 返回出错行列，不输出错误信息。
+  bool make_lexs(const char* const s, Error& err) {
+    Sign sig(s);
+    const QuietParse quiet;
+    return make_lexs(sig, err);
+  }
+  /// 特征码串生成 特征码词法组。特征码串不要求以 0 结尾。
+  bool make_lexs(const std::string_view s) {
+    Sign sig(s);
+    Error err;
+    return make_lexs(sig, err);
+  }
+  /// 特征码串生成 特征码词法组。特征码串不要求以 0 结尾。不输出错误信息。
+  bool make_lexs(const std::string_view s, Error& err) {
+    Sign sig(s);
+    const QuietParse quiet;
+    return make_lexs(sig, err);
+  }
+
+ private:
+  /// 期间本线程不输出解析错误。
+  struct QuietParse {
+    const bool old = quiet_parse;
+    QuietParse() { quiet_parse = true; }
+    ~QuietParse() { quiet_parse = old; }
+  };
+  bool make_lexs(Sign& sig, Error& err) {
     _lex.reset();
+    _recs.clear();
+    _names.reset();
 
-    Sign sig(s);
     xsdbg << gk_separation_line << "lexical...";
     while (make_lex(sig))
       ;
     xsdbg << gk_separation_line << "lexical done.";
+    sig.pos(err.row, err.col);
     if (!valid()) return false;
 
     xsdbg << gk_separation_line << "optimization...";
@@ -895,6 +1044,7 @@ class xsig {
     }
     xsdbg << "```";
 
+    make_index();
     return true;
   }
 
@@ -1041,8 +1191,12 @@ class xsig {
       const auto MM = bm((const uint8_t*)blk.begin() + lp, blk.size() - lp);
       xsdbg << "    MM " << (uint64_t)MM;
       if (MM < 0) return false;
-      auto a = (size_t)blk.begin() + lp + MM - LA;
-      auto b = (size_t)blk.begin() + lp + MM + LB;
+      // 重新给出的块限制在原块内。 LA 、 LB 可能为 MaxType ，注意溢出。
+      const auto off = (size_t)(lp + MM);
+      const auto a = (size_t)blk.begin() + ((off >= (size_t)LA) ? off - LA : 0);
+      const auto b = ((size_t)LB >= blk.size() - off)
+                         ? (size_t)blk.end()
+                         : (size_t)blk.begin() + off + LB;
       if (match_core(xblk((const void*)a, (const void*)b))) return true;
       lp += MM + 1;
     }
@@ -1051,7 +1205,13 @@ class xsig {
   }
   //////////////////////////////////////////////////////////////// match 内核
   /// 匹配内核。朴素匹配。
-  bool match_core(const xblk& blk) {
+  bool match_core(const xblk& blk) { return match_lexs(blk, false); }
+  /// 定点匹配。只在块起始位置匹配。
+  bool match_at(const xblk& blk) { return match_lexs(blk, true); }
+
+ private:
+  /// 朴素匹配。 anchor 为 true 时，只在块起始位置匹配。
+  bool match_lexs(const xblk& blk, const bool anchor) {
     try {
       xsdbg << gk_separation_line << "match... " << blk.begin() << " - "
             << blk.end();
@@ -1095,6 +1255,10 @@ class xsig {
 
         if (lex) continue;
         // 前面所有特征都达到了最大匹配，无法回退。则 回到顶，递增继续。
+        if (anchor) {
+          xsdbg << gk_separation_line << "anchor match fail";
+          return false;
+        }
         xsdbg << "reset and inc...";
         ++lp;
         lex = _lex;
@@ -1107,6 +1271,8 @@ class xsig {
       return false;
     }
   }
+
+ public:
   /// 指定块组，匹配特征。
   bool match(const Blks blks) {
     auto match_func =
@@ -1116,28 +1282,75 @@ class xsig {
     }
     return false;
   }
-  /// 提取特征匹配结果。
-  Reports report(const void* start) const {
-    Reports reps;
-    if (!valid()) {
+  /// 提取特征匹配结果到 FlatReports 。 reps 可重复使用以避免内存分配。
+  bool report(const void* start, FlatReports& reps) const {
+    reps._values.clear();
+    if (!valid() || !_names) {
       xserr << "xsig invalid, no report !";
-      return reps;
-    }
-    int inoname = 0;
-    for (auto lex = _lex; lex; lex = lex->child) {
-      if (Lexical::LT_Record != lex->type) continue;
-      const auto& r = *(const Lexical::Record*)lex.get();
-      auto name = r.name;
-      if (name.empty()) name.assign(xmsg().prt("noname%d", inoname++).toas());
-      reps.insert({name, r.pick_value(start)});
+      reps._names.reset();
+      return false;
     }
-    if (reps.empty()) {
+    if (reps._names != _names) reps._names = _names;
+    if (_recs.empty()) {
       value v;
       v.t = 'p';
       v.p = _lex->match_mem;
-      reps.insert({"noname", v});
+      reps._values.push_back(v);
+      return true;
     }
-    return reps;
+    for (const auto r : _recs) reps._values.push_back(r->pick_value(start));
+    return true;
+  }
+  /// 提取特征匹配结果。
+  Reports report(const void* start) const {
+    FlatReports reps;
+    if (!report(start, reps)) return Reports();
+    return reps.to_map();
+  }
+  /**
+    返回特征码的起始 hexs 串，即匹配位置必须以之起始的字节串。
+    起始非 hexs 时，返回空。（ sets 不占匹配内存，被跳过。）
+  */
+  std::string_view prefix() const {
+    if (!valid()) return std::string_view();
+    auto lex = _lex;
+    if (Lexical::LT_Sets == lex->type) lex = lex->child;
+    if (!lex || Lexical::LT_Hexs != lex->type) return std::string_view();
+    return ((const Lexical::Hexs*)lex.get())->str;
+  }
+  /**
+    深复制。
+
+    xsig 的复制共享词法链，而匹配状态记录在词法链中。
+    需要多个线程同时匹配同一特征码时，每个线程应使用各自的 clone 。
+  */
+  xsig clone() const {
+    xsig o;
+    if (!_lex) return o;
+    std::map<const Lexical::Base*, std::shared_ptr<Lexical::Base>> nodes;
+    std::shared_ptr<Lexical::Base> last;
+    for (auto lex = _lex; lex; lex = lex->child) {
+      auto x = lex->clone();
+      x->parent.reset();
+      x->child.reset();
+      nodes[lex.get()] = x;
+      if (last) {
+        last->child = x;
+        x->parent = last;
+      } else {
+        o._lex = x;
+      }
+      last = x;
+    }
+    for (auto lex = o._lex; lex; lex = lex->child) {
+      if (Lexical::LT_Record != lex->type) continue;
+      auto& r = *(Lexical::Record*)lex.get();
+      const auto ref = r.ref.lock();
+      if (ref) r.ref = nodes.at(ref.get());
+      o._recs.push_back(&r);
+    }
+    o._names = _names;
+    return o;
   }
   /// 转换为二进制。
   vbin to_bin() const {
@@ -1154,6 +1367,8 @@ class xsig {
   /// 从二进制读取。
   bool from_bin(vbin& bs) {
     _lex.reset();
+    _recs.clear();
+    _names.reset();
     std::shared_ptr<Lexical::Base> lex;
     try {
       while (!bs.empty()) {
@@ -1218,7 +1433,10 @@ class xsig {
         add_lex(lex);
         xsdbg << lex->sig();
         if (t == Lexical::LT_End) {
-          if (lex->parent.lock()) return true;
+          if (lex->parent.lock()) {
+            make_index();
+            return true;
+          }
           xserr << "bins empty !";
           return false;
         }
@@ -1301,91 +1519,451 @@ class xsig {
     return blks;
 #endif
   }
-  /// 读取特征码串。要求多段特征码串，以 单行 / 分隔。
-  static inline std::vector<std::string> read_sig(const std::string& _data) {
-    std::vector<std::string> sigs;
-    /*
-      注意到，这里不适合用 正则表达式分割文本。
-
-      - 加前缀 \n 是应对起始 / 的情况，可以组成 \n/ 。
-        - 起始为 / 时，可使起始简单形成一个 空串。空串被忽略。
-        - 起始非 / 时，\n 被加入 文本串，无影响。
-      - 加后缀 \n/\n 是应对无 / 结尾的情况。
-        - 结尾为 \n/ 时，使结尾简单形成一个 空串。空串被忽略。
-        - 结尾非 /n/ 时，用于标记结尾，无影响。
-    */
-    const std::string data = "\n" + _data + "\n/\n";
-    auto ds = data.begin();
-    for (size_t s = 0, e = 0, p = 0; e != data.size(); p = e + 2) {
-      e = data.find("\n/", p);
-      if (data.npos == e) break;
-
-      auto its = ds + s;
-      auto ite = ds + e;
+  /**
+    多线程并行生成特征码组。
 
-      // 如果不是单行 / ，则视为 sig 内容，继续。
-      // 注意，因为加了后缀，itn 不可能为 end() 。
-      auto itn = ite + 2;
-      if ('\r' == *itn) ++itn;
-      if ('\n' != *itn) continue;
+    \param strs     特征码串组，通常来自 read_sig 或 SigFile 。
+    \param errs     非空时，按索引顺序返回生成失败的特征码及出错行列，不输出错误信息。
+    \param threads  线程数。为 0 时，使用全部硬件线程。
+    \return         与 strs 一一对应的特征码组。生成失败的特征码 valid() 为 false 。
+  */
+  template <typename S>
+  static inline std::vector<xsig> make_sigs(
+      const std::vector<S>& strs,
+      std::vector<Error>* errs = nullptr,
+      size_t threads = 0) {
+    std::vector<xsig> sigs(strs.size());
+    if (0 == threads) threads = std::thread::hardware_concurrency();
+    threads = std::max<size_t>(1, std::min(threads, strs.size()));
+
+    std::atomic<size_t> next = 0;
+    std::vector<std::vector<Error>> terrs(threads);
+    const auto routine = [&](std::vector<Error>& es) {
+      for (auto i = next++; i < strs.size(); i = next++) {
+        Error err = {i, 0, 0};
+        try {
+          const std::string_view sv(strs[i]);
+          if (nullptr == errs ? sigs[i].make_lexs(sv)
+                              : sigs[i].make_lexs(sv, err)) {
+            continue;
+          }
+        } catch (...) {
+          xserr << "make_sigs " << i << " exception !";
+        }
+        es.push_back(err);
+      }
+    };
 
-      s = e + 2;  // 注意设定下个起始位。
+    std::vector<std::thread> ths;
+    for (size_t i = 1; i < threads; ++i) {
+      ths.emplace_back(routine, std::ref(terrs[i]));
+    }
+    routine(terrs[0]);
+    for (auto& th : ths) th.join();
 
-      // 前缀空白丢弃。
-      for (; its != ite; ++its) {
-        if (!isspace(*its)) break;
-      }
-      // 后缀空白丢弃。
-      for (; ite != its; --ite) {
-        if (!isspace(*(ite - 1))) break;
+    if (nullptr != errs) {
+      errs->clear();
+      for (const auto& es : terrs) {
+        errs->insert(errs->end(), es.begin(), es.end());
       }
-      // 空串丢弃。
-      if (its == ite) continue;
+      std::sort(errs->begin(), errs->end(),
+                [](const Error& a, const Error& b) { return a.index < b.index; });
+    }
+    return sigs;
+  }
+  /**
+    分割特征码串。要求多段特征码串，以 单行 / 分隔。
 
-      sigs.emplace_back(std::string(its, ite));
+    - 只返回指向 data 的 string_view ，不复制。
+    - 内容为 / 或 /\r 的行为分隔行。首行、末行同样适用。
+    - 各段去除前后空白，空段丢弃。
+  */
+  static inline std::vector<std::string_view> read_sig_view(
+      const std::string_view data) {
+    std::vector<std::string_view> sigs;
+    const auto push = [&sigs](std::string_view sig) {
+      while (!sig.empty() && isspace((uint8_t)sig.front())) sig.remove_prefix(1);
+      while (!sig.empty() && isspace((uint8_t)sig.back())) sig.remove_suffix(1);
+      if (!sig.empty()) sigs.push_back(sig);
+    };
+    // 注意到，这里不适合用 正则表达式分割文本。
+    size_t s = 0;
+    for (size_t b = 0; b < data.size();) {
+      auto e = data.find('\n', b);
+      if (data.npos == e) e = data.size();
+
+      const auto line = data.substr(b, e - b);
+      if (line == "/" || line == "/\r") {
+        push(data.substr(s, b - s));
+        s = e;  // 注意设定下个起始位。
+      }
+      b = e + 1;
     }
+    if (s < data.size()) push(data.substr(s));
 
     return sigs;
   }
-  /// 读取特征码文件。
-  static inline std::vector<std::string> read_sig_file(
-      const std::filesystem::path& path) {
+  /// 读取特征码串。要求多段特征码串，以 单行 / 分隔。
+  static inline std::vector<std::string> read_sig(const std::string& data) {
     std::vector<std::string> sigs;
-    std::ifstream file;
-    file.open(path, std::ios_base::in | std::ios_base::binary);
-    if (!file) {
-      xserr << "open sig file fail !";
-      return sigs;
-    }
+    for (const auto& v : read_sig_view(data)) sigs.emplace_back(v);
+    return sigs;
+  }
+  //////////////////////////////////////////////////////////////// SigFile 类
+  /**
+    只读映射特征码文件，并分割特征码串。
 
-    file.seekg(0, std::ios_base::end);
-    const size_t filelen = (size_t)file.tellg();
-    if (0 == filelen) {
-      xserr << "sig file empty !";
-      return sigs;
-    }
-    file.seekg(0, std::ios_base::beg);
-    std::string data;
-    data.resize(filelen);
-    file.read((char*)data.data(), filelen);
-    file.close();
+    - 特征码串为指向映射内存的 string_view ，只在对象存活期间有效。
+    - 映射期间，勿改写文件内容。更新文件建议写入新文件后替换。
 
-    if (data.size() >= 3 && "\xEF\xBB\xBF" == data.substr(0, 3)) {
-      data.erase(data.begin(), data.begin() + 3);
+    \code
+      xlib::xsig::SigFile file("sig.txt");
+      auto sigs = xlib::xsig::make_sigs(file.sigs());
+    \endcode
+  */
+  class SigFile {
+   public:
+    SigFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+      const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                    nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (INVALID_HANDLE_VALUE == file) {
+        xserr << "open sig file fail !";
+        return;
+      }
+      LARGE_INTEGER filelen;
+      if (FALSE == GetFileSizeEx(file, &filelen) || 0 == filelen.QuadPart) {
+        xserr << "sig file empty !";
+        CloseHandle(file);
+        return;
+      }
+      const auto map =
+          CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      CloseHandle(file);
+      if (nullptr == map) {
+        xserr << "map sig file fail !";
+        return;
+      }
+      _mem = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(map);
+      if (nullptr == _mem) {
+        xserr << "map sig file fail !";
+        return;
+      }
+      _size = (size_t)filelen.QuadPart;
+#else
+      const auto file = open(path.c_str(), O_RDONLY);
+      if (file < 0) {
+        xserr << "open sig file fail !";
+        return;
+      }
+      struct stat st;
+      if (0 != fstat(file, &st) || 0 == st.st_size) {
+        xserr << "sig file empty !";
+        close(file);
+        return;
+      }
+      const auto mem =
+          mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+      close(file);
+      if (MAP_FAILED == mem) {
+        xserr << "map sig file fail !";
+        return;
+      }
+      _mem = mem;
+      _size = (size_t)st.st_size;
+#endif
+      std::string_view data((const char*)_mem, _size);
+      if (data.size() >= 3 && "\xEF\xBB\xBF" == data.substr(0, 3)) {
+        data.remove_prefix(3);
+      }
+      _sigs = read_sig_view(data);
     }
+    SigFile(const SigFile&) = delete;
+    SigFile& operator=(const SigFile&) = delete;
+    ~SigFile() {
+      if (nullptr == _mem) return;
+#ifdef _WIN32
+      UnmapViewOfFile(_mem);
+#else
+      munmap(_mem, _size);
+#endif
+    }
+    /// 返回文件是否映射成功。
+    bool valid() const { return nullptr != _mem; }
+    /// 返回分割后的特征码串。
+    const std::vector<std::string_view>& sigs() const { return _sigs; }
 
-    return read_sig(data);
+   private:
+    void*                         _mem = nullptr;  //< 映射内存。
+    size_t                        _size = 0;       //< 映射大小。
+    std::vector<std::string_view> _sigs;           //< 特征码串。
+  };
+  /// 读取特征码文件。
+  static inline std::vector<std::string> read_sig_file(
+      const std::filesystem::path& path) {
+    std::vector<std::string> sigs;
+    const SigFile file(path);
+    for (const auto& v : file.sigs()) sigs.emplace_back(v);
+    return sigs;
   }
 
  private:
   std::shared_ptr<Lexical::Base> _lex;  //< 特征码起始词法。是一个双向链表。
+  std::vector<const Lexical::Record*> _recs;   //< record 索引，指向 _lex 链中结点。
+  std::shared_ptr<const Names>        _names;  //< 名称表，与 _recs 一一对应。
  public:
 #ifdef xsig_need_debug
   static inline bool dbglog = false;  //< 指示是否输出 debug 信息。
 #endif
   static inline bool exmatch = true;  //< match 函数使用 预处理。
+  /// 指示本线程是否不输出解析错误。
+  static inline thread_local bool quiet_parse = false;
+};
+
+//////////////////////////////////////////////////////////////// xsig_trie 类
+/**
+  合并特征码组的公共前缀匹配。
+
+  - 各特征码的起始 hexs 串合并成前缀树，每个候选位置只需遍历一次前缀树。
+  - 前缀完全匹配时，才对该特征码进行定点匹配。
+  - 没有起始 hexs 串的特征码，按原有方式单独匹配。
+  - 匹配结果按特征码各自提取。
+
+  \code
+    xlib::xsig_trie trie(xlib::xsig::make_sigs(file.sigs()));
+    for (const auto i : trie.match(blks)) {
+      const auto reps = trie[i].report(nullptr);
+    }
+  \endcode
+*/
+class xsig_trie {
+ public:
+  xsig_trie(std::vector<xsig> sigs) : _sigs(std::move(sigs)), _nodes(1) {
+    _root.fill(0);
+    for (size_t i = 0; i < _sigs.size(); ++i) {
+      if (!_sigs[i].valid()) continue;
+      const auto prefix = _sigs[i].prefix();
+      if (prefix.empty()) {
+        _others.push_back(i);
+        continue;
+      }
+      uint32_t node = 0;
+      for (const auto ch : prefix) node = insert(node, (uint8_t)ch);
+      _nodes[node].leaves.push_back(i);
+      ++_leaves;
+    }
+  }
+  size_t size() const { return _sigs.size(); }
+  xsig& operator[](const size_t i) { return _sigs[i]; }
+  const xsig& operator[](const size_t i) const { return _sigs[i]; }
+  /// 指定块组，匹配特征码组。返回匹配成功的特征码索引。
+  std::vector<size_t> match(const xsig::Blks& blks) {
+    std::vector<size_t> rets;
+    std::vector<bool> found(_sigs.size(), false);
+    for (const auto i : _others) {
+      if (!_sigs[i].match(blks)) continue;
+      found[i] = true;
+      rets.push_back(i);
+    }
+    // 只计入树中的特征码，全部匹配后提前结束。
+    size_t remain = _leaves;
+    for (const auto& blk : blks) {
+      const auto mem = (const uint8_t*)blk.begin();
+      const auto size = blk.size();
+      for (size_t pos = 0; pos < size && 0 != remain; ++pos) {
+        uint32_t node = _root[mem[pos]];
+        for (size_t k = pos + 1; 0 != node; ++k) {
+          for (const auto i : _nodes[node].leaves) {
+            if (found[i]) continue;
+            if (!_sigs[i].match_at(xblk(mem + pos, blk.end()))) continue;
+            found[i] = true;
+            rets.push_back(i);
+            --remain;
+          }
+          if (k >= size) break;
+          node = next(node, mem[k]);
+        }
+      }
+    }
+    return rets;
+  }
+
+ private:
+  /// 查找子结点，不存在时返回 0 。
+  uint32_t next(const uint32_t node, const uint8_t ch) const {
+    if (0 == node) return _root[ch];
+    for (const auto& v : _nodes[node].next) {
+      if (v.first == ch) return v.second;
+    }
+    return 0;
+  }
+  /// 查找子结点，不存在时添加。
+  uint32_t insert(const uint32_t node, const uint8_t ch) {
+    const auto n = next(node, ch);
+    if (0 != n) return n;
+    const auto newn = (uint32_t)_nodes.size();
+    _nodes.emplace_back();
+    if (0 == node) {
+      _root[ch] = newn;
+    } else {
+      _nodes[node].next.push_back({ch, newn});
+    }
+    return newn;
+  }
+
+ private:
+  struct Node {
+    std::vector<std::pair<uint8_t, uint32_t>> next;    //< 子结点。
+    std::vector<size_t>                       leaves;  //< 前缀在此结束的特征码。
+  };
+  std::vector<xsig>             _sigs;    //< 特征码组。
+  std::vector<Node>             _nodes;   //< 前缀树结点， 0 为根。
+  std::array<uint32_t, 0x100>   _root;    //< 根结点的子结点表。
+  std::vector<size_t>           _others;  //< 没有起始 hexs 串的特征码。
+  size_t                        _leaves = 0;  //< 树中的特征码数，不含无效的。
 };
+
+//////////////////////////////////////////////////////////////// xsigs 类
+/**
+  特征码组的加载与热替换。
+
+  - 在后台读取、生成新的特征码组，全部生成成功后，原子替换当前特征码组。
+  - get 取得当前特征码组的只读引用计数指针，无需加锁。
+  - xsig 匹配时会修改自身状态，同一 xsig 不能被多个线程同时匹配。
+    扫描线程应通过 Local 使用各自的副本，副本只在特征码组替换后重新复制。
+  - Local 每次只比较替换序号，序号变化时才读取引用计数指针。
+  - 替换后，仍在使用旧特征码组的扫描不受影响，旧组在最后的引用释放时销毁。
+  - 多次 reload 重叠时，以最后开始的为准，先开始而后完成的不会覆盖之。
+
+  \code
+    xlib::xsigs sigs;
+    auto ret = sigs.reload_async("sig.txt");  // 后台加载。
+    // 扫描线程。
+    xlib::xsigs::Local local(sigs);
+    const auto cur = local.get();
+    if (cur) for (auto& sig : *cur) sig.match(blks);
+  \endcode
+*/
+class xsigs {
+ public:
+  using Sigs = std::vector<xsig>;
+  using SigsPtr = std::shared_ptr<const Sigs>;
+
+  /// 扫描线程的特征码组副本。不可跨线程共享。
+  class Local {
+   public:
+    explicit Local(const xsigs& owner) : _owner(owner) {}
+    /// 取得本线程可匹配的特征码组。尚未加载时返回空。特征码组替换后自动更新。
+    Sigs* get() {
+      const auto ver = _owner.version();
+      if (ver != _ver) {
+        _ver = ver;
+        auto cur = _owner.get();
+        if (cur != _src) {
+          _sigs = cur ? clone(*cur) : Sigs();
+          _src = std::move(cur);
+        }
+      }
+      return _src ? &_sigs : nullptr;
+    }
+
+   private:
+    const xsigs&  _owner;
+    uint64_t      _ver = 0;  //< 副本对应的替换序号。
+    SigsPtr       _src;      //< 副本的来源。
+    Sigs          _sigs;     //< 副本。
+  };
+
+ public:
+  xsigs() = default;
+  xsigs(const xsigs&) = delete;
+  xsigs& operator=(const xsigs&) = delete;
+  /// 深复制特征码组，用于匹配。
+  static Sigs clone(const Sigs& sigs) {
+    Sigs ret;
+    ret.reserve(sigs.size());
+    for (const auto& sig : sigs) ret.push_back(sig.clone());
+    return ret;
+  }
+  /// 取得当前特征码组。只读，不可直接用于匹配。尚未加载时返回空。
+  SigsPtr get() const {
+#ifdef __cpp_lib_atomic_shared_ptr
+    return _sigs.load(std::memory_order_acquire);
+#else
+    return std::atomic_load_explicit(&_sigs, std::memory_order_acquire);
+#endif
+  }
+  /// 取得当前特征码组的替换序号。未替换过时为 0 ，每次替换后增大。
+  uint64_t version() const {
+    return _published.load(std::memory_order_acquire);
+  }
+  /// 替换当前特征码组。
+  void set(SigsPtr sigs) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    publish(std::move(sigs), ++_generation);
+  }
+  /// 读取并生成特征码文件，全部成功时替换当前特征码组，否则保留当前特征码组。
+  bool reload(const std::filesystem::path& path) {
+    const auto gen = ++_generation;
+    const xsig::SigFile file(path);
+    if (file.sigs().empty()) {
+      xserr << "xsigs reload : no sig !";
+      return false;
+    }
+    std::vector<xsig::Error> errs;
+    SigsPtr sigs =
+        std::make_shared<const Sigs>(xsig::make_sigs(file.sigs(), &errs));
+    for (const auto& err : errs) {
+      xserr << "xsigs reload : sig " << err.index << " error at [" << err.row
+            << "][" << err.col << "] !";
+    }
+    if (!errs.empty()) return false;
+    std::lock_guard<std::mutex> lock(_mutex);
+    // 之后开始的 reload 已替换，放弃较旧的结果。
+    if (gen < _published.load(std::memory_order_relaxed)) {
+      xserr << "xsigs reload : superseded by newer reload !";
+      return false;
+    }
+    publish(std::move(sigs), gen);
+    return true;
+  }
+  /**
+    后台执行 reload 。注意：本对象需存活至后台执行结束。
+    返回的 future 析构时会等待后台执行结束，不可丢弃。
+  */
+  [[nodiscard]] std::future<bool> reload_async(
+      const std::filesystem::path& path) {
+    return std::async(std::launch::async,
+                      [this, path] { return reload(path); });
+  }
+
+ private:
+  /// 需持有 _mutex 。先替换指针，再发布序号，读到新序号即可读到新指针。
+  void publish(SigsPtr sigs, const uint64_t gen) {
+#ifdef __cpp_lib_atomic_shared_ptr
+    _sigs.store(std::move(sigs), std::memory_order_release);
+#else
+    std::atomic_store_explicit(&_sigs, std::move(sigs),
+                               std::memory_order_release);
+#endif
+    _published.store(gen, std::memory_order_release);
+  }
+
+ private:
+#ifdef __cpp_lib_atomic_shared_ptr
+  std::atomic<SigsPtr>  _sigs;
+#else
+  SigsPtr               _sigs;
+#endif
+  std::mutex            _mutex;           //< 串行化替换。
+  std::atomic<uint64_t> _generation = 0;  //< reload 开始的序号。
+  std::atomic<uint64_t> _published = 0;   //< 已替换的序号。
+};
+
 #undef xsig_is_x64
+#undef xsperr
 #undef xserr
 #undef xsdbg
 #undef xslog
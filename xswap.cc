@@ -29,6 +29,23 @@ SHOW_TEST_HEAD(bswap enum);
 done = xlib::bswap(xte_0) == xte_0;
 SHOW_TEST_RESULT;
 
+SHOW_TEST_HEAD(bswaps);
+uint32_t a32[11];
+uint64_t a64[5];
+uint16_t a16[17];
+for (size_t i = 0; i < 11; ++i) a32[i] = (uint32_t)(0x01020304 * (i + 1));
+for (size_t i = 0; i < 5; ++i) a64[i] = 0x0102030405060708 * (i + 1);
+for (size_t i = 0; i < 17; ++i) a16[i] = (uint16_t)(0x0102 * (i + 1));
+uint32_t b32[11];
+xlib::bswaps<uint32_t>(b32, a32, 11);
+xlib::bswaps<uint64_t>(a64, a64, 5);
+xlib::bswaps<uint16_t>((uint8_t*)a16 + 0, a16, 17);
+done = true;
+for (size_t i = 0; i < 11; ++i) done = done && b32[i] == xlib::bswap((uint32_t)(0x01020304 * (i + 1)));
+for (size_t i = 0; i < 5; ++i) done = done && a64[i] == xlib::bswap(0x0102030405060708 * (i + 1));
+for (size_t i = 0; i < 17; ++i) done = done && a16[i] == xlib::bswap((uint16_t)(0x0102 * (i + 1)));
+SHOW_TEST_RESULT;
+
 SHOW_TEST_HEAD(seqswap);
 void* a = (void*)0x2;
 void* b = (void*)0x1;
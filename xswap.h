@@ -2,7 +2,7 @@
   \file  xswap.h
   \brief 定义了 swap 的相关模板。
 
-  \version    2.2.0.230224
+  \version    2.3.0.261019
 
   \author     triones
   \date       2014-01-07
@@ -16,13 +16,21 @@
   - 2019-09-20 重构 bswap 。 2.0 。
   - 2019-11-05 升级声明。 2.1 。
   - 2021-08-05 升级定义。 2.2 。
+  - 2026-10-19 新增 bswaps ，批量翻转数组，支持 SSE2 时向量化。 2.3 。
 */
 #ifndef _XLIB_XSWAP_H_
 #define _XLIB_XSWAP_H_
 
 #include <cstdint>
+#include <cstring>
 #include <algorithm>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XSWAP_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace xlib {
 
 #ifdef _WIN32
@@ -76,6 +84,51 @@ bswap(const T& values) {
 #undef xbswap32
 #undef xbswap64
 
+/**
+  批量翻转数组。支持 SSE2 时，每次处理 16 byte 。
+  \param    dst   目标地址，不要求对齐。允许与 src 相同。
+  \param    src   源地址，不要求对齐。
+  \param    n     元素个数。
+
+  \code
+    uint32_t a[4] = {...};
+    bswaps<uint32_t>(a, a, 4);
+  \endcode
+*/
+template <typename T> inline
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, void>
+bswaps(void* const dst, const void* const src, const size_t n) {
+  auto d = (uint8_t*)dst;
+  auto s = (const uint8_t*)src;
+  if constexpr (sizeof(T) == sizeof(uint8_t)) {
+    if (d != s) memmove(d, s, n);
+    return;
+  }
+  size_t i = 0;
+#ifdef XSWAP_SSE2
+  constexpr size_t step = sizeof(__m128i) / sizeof(T);
+  for (; i + step <= n; i += step) {
+    auto x = _mm_loadu_si128((const __m128i*)(s + i * sizeof(T)));
+    // 先在 T 内翻转 word 顺序，再翻转每个 word 内的 byte 。
+    if constexpr (sizeof(T) == sizeof(uint32_t)) {
+      x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+      x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+    } else if constexpr (sizeof(T) == sizeof(uint64_t)) {
+      x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(0, 1, 2, 3));
+      x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+    x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+    _mm_storeu_si128((__m128i*)(d + i * sizeof(T)), x);
+  }
+#endif
+  for (; i < n; ++i) {
+    T v;
+    memcpy(&v, s + i * sizeof(T), sizeof(T));
+    v = bswap(v);
+    memcpy(d + i * sizeof(T), &v, sizeof(T));
+  }
+}
+
 /**
   当 A > B 时，对调两值，并返回真。否则不变，返回假。
   \param    a   任意类型非常量值。
@@ -97,4 +150,6 @@ bool seqswap(T& a, T& b) {
 
 }  // namespace xlib
 
+#undef XSWAP_SSE2
+
 #endif  // _XLIB_XSWAP_H_
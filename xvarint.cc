@@ -2,6 +2,10 @@
 
 #include "xlib_test.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 enum xvarint_enum {
   XVE_0,
   XVE_1,
@@ -38,6 +42,22 @@ constexpr xlib::xvarint v32((uint32_t)0x87654321);
 done = "\xA1\x86\x95\xBB\x08" == std::string((const char*)v32.data(), v32.size());
 SHOW_TEST_RESULT;
 
+SHOW_TEST_HEAD(xvarint size);
+static_assert(xlib::xvarint((uint32_t)0x87654321).size() == 5);
+static_assert(xlib::xvarint((uint8_t)0).size() == 1);
+static_assert(xlib::xvarint((int64_t)-1).size() == 1);
+static_assert(xlib::xvarint_size(UINT64_MAX) == 10);
+done = true;
+for (int bits = 0; bits <= 64; ++bits) {
+  const uint64_t u = (bits == 64) ? UINT64_MAX : ((uint64_t)1 << bits) - 1;
+  const xlib::xvarint x(u);
+  size_t n = 1;
+  while (n < 10 && (x.data()[n - 1] & 0x80)) ++n;
+  done = done && x.size() == n && n == (bits == 0 ? 1 : ((size_t)bits + 6) / 7) &&
+         0 == (x.data()[n - 1] & 0x80);
+}
+SHOW_TEST_RESULT;
+
 SHOW_TEST_HEAD(xvarint T* signed);
 done = 12345678 == xlib::xvarint<int32_t>("\x9C\x85\xE3\x0B");
 SHOW_TEST_RESULT;
@@ -53,4 +73,133 @@ xvarint_enum ex = xlib::xvarint<xvarint_enum>(xx.data());
 done = ex == ee;
 SHOW_TEST_RESULT;
 
+SHOW_TEST_HEAD(xvarints);
+{
+  std::vector<int64_t> vs;
+  for (int64_t i = -20; i < 20; ++i) vs.push_back(i);
+  for (int64_t i = 1; i < 60; ++i) vs.push_back(((int64_t)1 << i) - 3);
+  vs.push_back(INT64_MIN);
+  vs.push_back(INT64_MAX);
+  std::string ref;
+  for (const auto v : vs) {
+    const xlib::xvarint x(v);
+    ref.append((const char*)x.data(), x.size());
+  }
+  std::string buf(vs.size() * xlib::xvarint_max<int64_t>, '\0');
+  const auto b = (uint8_t*)buf.data();
+  const auto e = xlib::xvarints_encode(b, vs.data(), vs.size());
+  buf.resize(e - b);
+  std::vector<int64_t> rs(vs.size());
+  const auto pe = (const uint8_t*)buf.data() + buf.size();
+  done = buf == ref &&
+         xlib::xvarints_decode(rs.data(), rs.size(), b, pe) == pe &&
+         rs == vs &&
+         xlib::xvarints_decode(rs.data(), rs.size(), b, pe - 1) == nullptr;
+  const uint8_t over[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x01};
+  uint32_t u;
+  done = done && xlib::xvarints_decode(&u, 1, over, over + sizeof(over)) == nullptr;
+  // 1 、 2 byte 混合，夹杂少量长值。
+  std::vector<int32_t> ms;
+  uint32_t seed = 0x12345678;
+  for (size_t i = 0; i < 1000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const auto r = (int32_t)(seed >> 8);
+    ms.push_back((0 == i % 37) ? r : ((0 == (seed & 0x10)) ? r % 64 : r % 8192));
+  }
+  std::string mbuf(ms.size() * xlib::xvarint_max<int32_t>, '\0');
+  const auto mb = (uint8_t*)mbuf.data();
+  const auto me = xlib::xvarints_encode(mb, ms.data(), ms.size());
+  std::vector<int32_t> mr(ms.size());
+  done = done && xlib::xvarints_decode(mr.data(), mr.size(), mb, me) == me &&
+         mr == ms;
+  // 个数在组内结束时，停在该值结尾。
+  const auto m3 = mb + xlib::xvarint_size(ms[0]) + xlib::xvarint_size(ms[1]) +
+                  xlib::xvarint_size(ms[2]);
+  done = done && xlib::xvarints_decode(mr.data(), 3, mb, me) == m3;
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xvarint_decode);
+{
+  done = true;
+  uint8_t buf[0x20];
+  for (int bits = 0; bits < 64; ++bits) {
+    for (const uint64_t u : {(uint64_t)1 << bits, ((uint64_t)1 << bits) - 1,
+                             ~(uint64_t)0 >> bits}) {
+      const xlib::xvarint x(u);
+      const auto len = x.size();
+      memset(buf, 0xFF, sizeof(buf));
+      memcpy(buf, x.data(), len);
+      uint64_t v = 0;
+      // 有余量时走快速路径，恰好结尾时走逐 byte 路径。
+      done = done && len == xlib::xvarint_decode(v, buf, buf + sizeof(buf)) && v == u;
+      v = 0;
+      done = done && len == xlib::xvarint_decode(v, buf, buf + len) && v == u;
+      done = done && 0 == xlib::xvarint_decode(v, buf, buf + len - 1);
+      const auto s = (int64_t)u;
+      const xlib::xvarint xs(s);
+      memcpy(buf, xs.data(), xs.size());
+      int64_t sv = 0;
+      done = done && xs.size() == xlib::xvarint_decode(sv, buf, buf + sizeof(buf)) && sv == s;
+    }
+  }
+  const uint8_t over[0x10] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x01};
+  uint32_t u32 = 7;
+  uint16_t u16 = 7;
+  done = done && 0 == xlib::xvarint_decode(u32, over, over + sizeof(over)) &&
+         0 == xlib::xvarint_decode(u16, over, over + sizeof(over)) &&
+         u32 == 7 && u16 == 7 &&
+         5 == xlib::xvarint_decode(u32, over + 1, over + sizeof(over)) &&
+         u32 == ((uint32_t)1 << 28);
+}
+SHOW_TEST_RESULT;
+
+SHOW_TEST_HEAD(xdelta);
+{
+  std::vector<uint32_t> ids;
+  std::vector<int64_t> ts;
+  uint32_t id = 1000000;
+  int64_t t = 1700000000000;
+  for (size_t i = 0; i < 1000; ++i) {
+    id += (uint32_t)(i * 7 % 13 + 1);
+    t += (int64_t)(i * 31 % 17) - 5;
+    ids.push_back(id);
+    ts.push_back(t);
+  }
+  ids[500] = 3;  // 乱序值。
+  done = true;
+  for (const size_t n : {(size_t)0, (size_t)1, (size_t)127, (size_t)128, (size_t)300, ids.size()}) {
+    std::string b1(n * xlib::xvarint_max<uint32_t>, '\0');
+    std::string b2(n * xlib::xvarint_max<int64_t>, '\0');
+    std::string b3(n * xlib::xvarint_max<uint32_t>, '\0');
+    const auto p1 = (uint8_t*)b1.data();
+    const auto p2 = (uint8_t*)b2.data();
+    const auto p3 = (uint8_t*)b3.data();
+    const auto e1 = xlib::xdelta_encode(p1, ids.data(), n);
+    const auto e2 = xlib::xdelta_pack(p2, ts.data(), n);
+    const auto e3 = xlib::xdelta_pack(p3, ids.data(), n);
+    std::vector<uint32_t> r1(n);
+    std::vector<int64_t> r2(n);
+    std::vector<uint32_t> r3(n);
+    done = done && xlib::xdelta_decode(r1.data(), n, p1, e1) == e1 &&
+           xlib::xdelta_unpack(r2.data(), n, p2, e2) == e2 &&
+           xlib::xdelta_unpack(r3.data(), n, p3, e3) == e3 &&
+           std::equal(r1.begin(), r1.end(), ids.begin()) &&
+           std::equal(r2.begin(), r2.end(), ts.begin()) &&
+           std::equal(r3.begin(), r3.end(), ids.begin());
+    if (n != 0) {
+      done = done && xlib::xdelta_decode(r1.data(), n, p1, e1 - 1) == nullptr &&
+             xlib::xdelta_unpack(r2.data(), n, p2, e2 - 1) == nullptr;
+    }
+  }
+  // 时间戳差值编码远小于逐个 varint 编码。
+  std::string raw(ts.size() * xlib::xvarint_max<int64_t>, '\0');
+  const auto pr = (uint8_t*)raw.data();
+  const auto rawsize = xlib::xvarints_encode(pr, ts.data(), ts.size()) - pr;
+  const auto dsize = xlib::xdelta_encode(pr, ts.data(), ts.size()) - pr;
+  const auto psize = xlib::xdelta_pack(pr, ts.data(), ts.size()) - pr;
+  done = done && dsize * 4 < rawsize && psize < dsize;
+}
+SHOW_TEST_RESULT;
+
 SHOW_TEST_DONE;
\ No newline at end of file
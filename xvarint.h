@@ -2,7 +2,7 @@
   \file  xvarint.h
   \brief 定义了 zig 、 zag 、 varint 相关操作。
 
-  \version    2.0.0.230227
+  \version    2.4.1.261019
   \note       For All
 
   \author     triones
@@ -15,13 +15,28 @@
   - 2019-10-21 改进。1.1 。
   - 2019-11-06 重构 zig 、 zag 。 1.2 。
   - 2020-03-13 重构 varint 。 2.0 。
+  - 2026-10-19 修正解码时 int 移位溢出，允许冗余 0x80 补齐的编码。 2.0.1 。
+  - 2026-10-19 新增 xvarints_encode 、 xvarints_decode ，批量编解码。 2.1 。
+  - 2026-10-19 新增 xvarint_decode ，有界解码，一次读取 8 byte 查找结尾。 2.2 。
+  - 2026-10-19 编码前以有效位数计算长度， size 不再扫描。 2.3 。
+  - 2026-10-19 新增 xdelta ，差值编码整数序列，可按 128 个一组位压缩。 2.4 。
+  - 2026-10-19 xvarints_decode 批量解码 1 、 2 byte 混合的值。 2.4.1 。
 */
 #ifndef _XLIB_XVARINT_H_
 #define _XLIB_XVARINT_H_
 
+#include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
 
 namespace xlib {
 
@@ -51,6 +66,45 @@ xzag(const T& v) {
   }
 }
 
+/// T 的 varint 最大编码长度。
+template <typename T>
+inline constexpr size_t xvarint_max = sizeof(T) / CHAR_BIT + 1 + sizeof(T);
+
+/// 计算 varint 编码长度。以有效位数（ countl_zero ）直接计算，无循环。
+template <typename T> inline constexpr
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, size_t>
+xvarint_size(const T& value) {
+  using U = typename std::make_unsigned_t<T>;
+  const auto v = (uint64_t)(U)xzig(value);
+#ifdef __cpp_lib_bitops
+  const size_t bits = (size_t)std::bit_width(v);
+#else
+  size_t bits = 0;
+  for (auto x = v; x != 0; x >>= 1) ++bits;
+#endif
+  return (bits == 0) ? 1 : (bits + (CHAR_BIT - 2)) / (CHAR_BIT - 1);
+}
+
+/**
+  varint 编码。先计算长度，再按固定次数写出，无数据相关的分支。
+  \param   p       输出缓冲，至少需要 xvarint_max<T> 。
+  \param   value   数值。
+  \return          编码长度。
+*/
+template <typename T> inline constexpr
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, size_t>
+xvarint_encode(uint8_t* const p, const T& value) {
+  using U = typename std::make_unsigned_t<T>;
+  auto v = (U)xzig(value);
+  const size_t len = xvarint_size(value);
+  for (size_t i = 0; i + 1 < len; ++i) {
+    p[i] = (uint8_t)(v & 0x7F) | 0x80;
+    v >>= (CHAR_BIT - 1);
+  }
+  p[len - 1] = (uint8_t)v;
+  return len;
+}
+
 template <typename T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, int> = 0>
 class xvarint : public std::array<uint8_t, sizeof(T) / CHAR_BIT + 1 + sizeof(T)> {
  public:
@@ -58,35 +112,20 @@ class xvarint : public std::array<uint8_t, sizeof(T) / CHAR_BIT + 1 + sizeof(T)>
 
  private:
   T _value;
+  size_t _size;
 
  public:
   constexpr xvarint(const T& value)
       : std::array<uint8_t, sizeof(T) / CHAR_BIT + 1 + sizeof(T)>(),
-        _value(value) {
+        _value(value),
+        _size(xvarint_encode(base::data(), value)) {
     // g++ 这里有 will be initialized after 警告，可忽略。
-    using U = typename std::make_unsigned_t<T>;
-    auto v = (U)xzig(value);
-    for (auto& pv : *this) {
-      const auto vv = (uint8_t)(v & 0x7F);
-      v >>= (CHAR_BIT - 1);
-      if (0 == v) {
-        pv = vv;
-        break;
-      }
-      pv = vv | 0x80;
-    }
   }
   constexpr uint8_t* data() const noexcept {
     return (uint8_t*)base::data();
   }
   constexpr size_t size() const noexcept {
-    size_t n = 0;
-    for (const auto& v : *this) {
-      ++n;
-      // g++ 这里有 may be used uninitialized in this function 警告，可忽略。
-      if (0 == (v & 0x80)) break;
-    }
-    return n;
+    return _size;
   }
   constexpr operator T() const noexcept {
     return _value;
@@ -94,15 +133,14 @@ class xvarint : public std::array<uint8_t, sizeof(T) / CHAR_BIT + 1 + sizeof(T)>
   constexpr T operator()() const noexcept {
     return _value;
   }
-  constexpr xvarint(const char* p) : _value(T()) {
+  constexpr xvarint(const char* p) : base(), _value(T()), _size(0) {
     using U = typename std::make_unsigned_t<T>;
     U v = 0;
-    size_t count = 0;
     for (auto& pv : *this) {
       pv = *p;
       ++p;
-      v |= ((pv & 0x7F) << (count * (CHAR_BIT - 1)));
-      ++count;
+      v |= ((U)(pv & 0x7F) << (_size * (CHAR_BIT - 1)));
+      ++_size;
       if (0 == (pv & 0x80)) {
         _value = xzag((T)v);
         break;
@@ -113,6 +151,371 @@ class xvarint : public std::array<uint8_t, sizeof(T) / CHAR_BIT + 1 + sizeof(T)>
   xvarint(const Ty* p) : xvarint((const char*)p) {}
 };
 
+/// 计算末尾 0 bit 个数。 v 不能为 0 。
+inline int xvarint_ctz(const uint64_t v) {
+#ifdef __cpp_lib_bitops
+  return std::countr_zero(v);
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_WIN64)
+  unsigned long index;
+  _BitScanForward64(&index, v);
+  return (int)index;
+#elif defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  if (_BitScanForward(&index, (unsigned long)v)) return (int)index;
+  _BitScanForward(&index, (unsigned long)(v >> 32));
+  return (int)index + 32;
+#else
+  return __builtin_ctzll(v);
+#endif
+}
+
+/**
+  有界 varint 解码，格式与 xvarint 一致。
+  \param   v     输出值。失败时不修改。
+  \param   p     编码数据。
+  \param   end   编码数据结尾，不会越界读取。
+  \return        读取字节数。数据不足或编码超长时返回 0 。
+
+  \note    剩余数据不少于 xvarint_max<uint64_t> 时，一次读取 8 byte ，
+           以 ctz 查找结尾，再并行合并 7 bit 组，无逐 byte 分支。
+*/
+template <typename T> inline
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, size_t>
+xvarint_decode(T& v, const uint8_t* const p, const uint8_t* const end) {
+  using U = typename std::make_unsigned_t<T>;
+  const size_t remain = (p < end) ? (size_t)(end - p) : 0;
+#ifdef __cpp_lib_endian
+  if constexpr (std::endian::native == std::endian::little) {
+    if (remain >= xvarint_max<uint64_t>) {
+      uint64_t w;
+      memcpy(&w, p, sizeof(w));
+      const uint64_t stop = ~w & 0x8080808080808080ull;
+      if (0 != stop) {
+        const size_t len = (size_t)(xvarint_ctz(stop) + 1) / CHAR_BIT;
+        if (len > xvarint_max<T>) return 0;
+        if (len < sizeof(w)) w &= ((uint64_t)1 << (len * CHAR_BIT)) - 1;
+        w &= 0x7F7F7F7F7F7F7F7Full;
+        w = ((w & 0x7F007F007F007F00ull) >> 1) | (w & 0x007F007F007F007Full);
+        w = ((w & 0x3FFF00003FFF0000ull) >> 2) | (w & 0x00003FFF00003FFFull);
+        w = ((w & 0x0FFFFFFF00000000ull) >> 4) | (w & 0x000000000FFFFFFFull);
+        v = xzag((T)(U)w);
+        return len;
+      }
+    }
+  }
+#endif
+  U u = 0;
+  for (size_t count = 0; count < xvarint_max<T> && count < remain; ++count) {
+    const auto pv = p[count];
+    u |= ((U)(pv & 0x7F) << (count * (CHAR_BIT - 1)));
+    if (0 == (pv & 0x80)) {
+      v = xzag((T)u);
+      return count + 1;
+    }
+  }
+  return 0;
+}
+
+/**
+  批量 varint 编码，格式与 xvarint 一致。
+  \param   p     输出缓冲，至少需要 n * xvarint_max<T> 。
+  \param   src   数组。
+  \param   n     元素个数。
+  \return        编码结尾。
+
+  \note    连续 8 个值都小于 0x80 时，整组写出单字节编码。
+*/
+template <typename T> inline
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, uint8_t*>
+xvarints_encode(uint8_t* p, const T* const src, const size_t n) {
+  using U = typename std::make_unsigned_t<std::remove_cv_t<T>>;
+  size_t i = 0;
+  while (i < n) {
+    if (i + 8 <= n) {
+      U u[8];
+      U m = 0;
+      for (size_t k = 0; k < 8; ++k) {
+        u[k] = (U)xzig(src[i + k]);
+        m |= u[k];
+      }
+      if (m < 0x80) {
+        for (size_t k = 0; k < 8; ++k) p[k] = (uint8_t)u[k];
+        p += 8;
+        i += 8;
+        continue;
+      }
+    }
+    p += xvarint_encode(p, src[i]);
+    ++i;
+  }
+  return p;
+}
+
+/**
+  批量 varint 解码，格式与 xvarint 一致。
+  \param   dst   输出数组。
+  \param   n     元素个数。
+  \param   p     编码数据。
+  \param   end   编码数据结尾，不会越界读取。
+  \return        解码结尾。数据不足或编码超长时返回 nullptr 。
+
+  \note    一次读取 8 byte ，检查最高位：
+           - 全部为 0 时，整组解码为单字节值。
+           - 前 4 个值均不超过 2 byte 时，以结尾位取出合并这 4 个值。
+           - 否则以 xvarint_decode 解码单个值。
+*/
+template <typename T> inline
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, const uint8_t*>
+xvarints_decode(T* const dst, const size_t n,
+                const uint8_t* p, const uint8_t* const end) {
+  size_t i = 0;
+  while (i < n) {
+    if (end - p >= 8) {
+      uint64_t w;
+      memcpy(&w, p, sizeof(w));
+      const uint64_t more = w & 0x8080808080808080ull;
+      if (0 == more && i + 8 <= n) {
+        for (size_t k = 0; k < 8; ++k) dst[i + k] = xzag((T)p[k]);
+        p += 8;
+        i += 8;
+        continue;
+      }
+#ifdef __cpp_lib_endian
+      // 首个值不超过 2 byte 时，尝试固定取 4 个值，无数据相关的分支。
+      if constexpr (std::endian::native == std::endian::little) {
+        if (i + 4 <= n && 0x8080 != (more & 0x8080)) {
+          uint64_t stop = more ^ 0x8080808080808080ull;
+          // 相邻续位处起为超过 2 byte 的值，只取其前的值。
+          const uint64_t lng = more & (more << 8);
+          if (0 != lng) stop &= ((lng & (0 - lng)) >> 8) - 1;
+          uint64_t s3 = stop & (stop - 1);
+          s3 &= s3 - 1;
+          s3 &= s3 - 1;
+          if (0 != s3) {
+            size_t s = 0;
+            for (size_t k = 0; k < 4; ++k) {
+              const size_t e = (size_t)xvarint_ctz(stop) / CHAR_BIT;
+              const auto x = (uint32_t)(w >> (s * CHAR_BIT)) &
+                             ((e != s) ? 0x7F7Fu : 0x7Fu);
+              dst[i + k] = xzag((T)((x & 0x7F) | ((x >> 1) & 0x3F80)));
+              s = e + 1;
+              stop &= stop - 1;
+            }
+            p += s;
+            i += 4;
+            continue;
+          }
+        }
+      }
+#endif
+    }
+    const size_t len = xvarint_decode(dst[i], p, end);
+    if (0 == len) return nullptr;
+    p += len;
+    ++i;
+  }
+  return p;
+}
+
+/**
+  差值编码。每个值与前一个值（首个与 base ）的差值经 zig 后 varint 编码。
+  适用于有序或变化平缓的序列，如 ID 列表、时间戳。
+  \param   p     输出缓冲，至少需要 n * xvarint_max<T> 。
+  \param   src   数组。
+  \param   n     元素个数。
+  \param   base  首个值的参考值，解码时需一致。
+  \return        编码结尾。
+*/
+template <typename T> inline
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, uint8_t*>
+xdelta_encode(uint8_t* p, const T* const src, const size_t n,
+              const std::remove_cv_t<T> base = {}) {
+  using U = typename std::make_unsigned_t<std::remove_cv_t<T>>;
+  using S = typename std::make_signed_t<U>;
+  auto prev = (U)base;
+  for (size_t i = 0; i < n; ++i) {
+    const auto cur = (U)src[i];
+    p += xvarint_encode(p, (S)(U)(cur - prev));
+    prev = cur;
+  }
+  return p;
+}
+
+/**
+  差值解码，与 xdelta_encode 对应。
+  \return  解码结尾。数据不足或编码超长时返回 nullptr 。
+*/
+template <typename T> inline
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, const uint8_t*>
+xdelta_decode(T* const dst, const size_t n,
+              const uint8_t* p, const uint8_t* const end, const T base = {}) {
+  using U = typename std::make_unsigned_t<T>;
+  using S = typename std::make_signed_t<U>;
+  auto prev = (U)base;
+  for (size_t i = 0; i < n; ++i) {
+    S d;
+    const size_t len = xvarint_decode(d, p, end);
+    if (0 == len) return nullptr;
+    p += len;
+    prev += (U)d;
+    dst[i] = (T)prev;
+  }
+  return p;
+}
+
+/// xdelta_pack 每组的元素个数。
+inline constexpr size_t xdelta_block = 128;
+
+/**
+  差值编码，按 xdelta_block 个一组位压缩（ frame of reference ）。
+
+  - 首个值以 xdelta_encode 格式单独编码，避免其差值拉大首组位宽。
+  - 每组写 1 byte 位宽 b 、组内最小差值 min （ varint ），
+    再写 xdelta_block 个 b bit 的 (差值 - min) ，共 xdelta_block * b / 8 byte ，小端序。
+  - 不足一组的结尾，以 xdelta_encode 格式编码。
+  - 每组位宽固定，解包为定长循环，利于编译器向量化。
+
+  \param   p     输出缓冲，至少需要 n * xvarint_max<T> 。
+  \return        编码结尾。
+*/
+template <typename T> inline
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, uint8_t*>
+xdelta_pack(uint8_t* p, const T* const src, const size_t n) {
+  using U = typename std::make_unsigned_t<std::remove_cv_t<T>>;
+  using S = typename std::make_signed_t<U>;
+  constexpr size_t words_max = xdelta_block * sizeof(U) / sizeof(uint64_t);
+  if (0 == n) return p;
+  p = xdelta_encode(p, src, 1);
+  auto prev = (U)src[0];
+  size_t i = 1;
+  for (; i + xdelta_block <= n; i += xdelta_block) {
+    S d[xdelta_block];
+    for (size_t k = 0; k < xdelta_block; ++k) {
+      const auto cur = (U)src[i + k];
+      d[k] = (S)(U)(cur - prev);
+      prev = cur;
+    }
+    const S min = *std::min_element(d, d + xdelta_block);
+    uint64_t z[xdelta_block];
+    uint64_t m = 0;
+    for (size_t k = 0; k < xdelta_block; ++k) {
+      z[k] = (uint64_t)(U)((U)d[k] - (U)min);
+      m |= z[k];
+    }
+    size_t b = 0;
+    for (; m != 0; m >>= 1) ++b;
+    *p++ = (uint8_t)b;
+    p += xvarint_encode(p, min);
+
+    uint64_t w[words_max + 1] = {};
+    for (size_t k = 0; k < xdelta_block; ++k) {
+      const size_t bit = k * b;
+      const size_t s = bit % 64;
+      w[bit / 64] |= z[k] << s;
+      if (s + b > 64) w[bit / 64 + 1] |= z[k] >> (64 - s);
+    }
+    const size_t words = xdelta_block * b / 64;
+    for (size_t k = 0; k < words; ++k) {
+      for (size_t j = 0; j < sizeof(uint64_t); ++j) {
+        *p++ = (uint8_t)(w[k] >> (j * CHAR_BIT));
+      }
+    }
+  }
+  // 结尾以 xdelta_encode 编码，接续前一组的最后一个值。
+  return xdelta_encode(p, src + i, n - i, (std::remove_cv_t<T>)prev);
+}
+
+/**
+  位压缩差值解码，与 xdelta_pack 对应。
+  \return  解码结尾。数据不足或数据错误时返回 nullptr 。
+*/
+template <typename T> inline
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, const uint8_t*>
+xdelta_unpack(T* const dst, const size_t n,
+              const uint8_t* p, const uint8_t* const end) {
+  using U = typename std::make_unsigned_t<T>;
+  using S = typename std::make_signed_t<U>;
+  constexpr size_t words_max = xdelta_block * sizeof(U) / sizeof(uint64_t);
+  if (0 == n) return p;
+  p = xdelta_decode(dst, 1, p, end);
+  if (nullptr == p) return nullptr;
+  auto prev = (U)dst[0];
+  size_t i = 1;
+  for (; i + xdelta_block <= n; i += xdelta_block) {
+    if (p >= end) return nullptr;
+    const size_t b = *p++;
+    if (b > sizeof(U) * CHAR_BIT) return nullptr;
+    S min;
+    const size_t len = xvarint_decode(min, p, end);
+    if (0 == len) return nullptr;
+    p += len;
+    const size_t words = xdelta_block * b / 64;
+    if ((size_t)(end - p) < words * sizeof(uint64_t)) return nullptr;
+
+    uint64_t w[words_max + 1] = {};
+    for (size_t k = 0; k < words; ++k) {
+      for (size_t j = 0; j < sizeof(uint64_t); ++j) {
+        w[k] |= (uint64_t)*p++ << (j * CHAR_BIT);
+      }
+    }
+    const uint64_t mask = (b == 64) ? ~(uint64_t)0 : ((uint64_t)1 << b) - 1;
+    for (size_t k = 0; k < xdelta_block; ++k) {
+      const size_t bit = k * b;
+      const size_t s = bit % 64;
+      uint64_t z = w[bit / 64] >> s;
+      if (s + b > 64) z |= w[bit / 64 + 1] << (64 - s);
+      prev += (U)(z & mask) + (U)min;
+      dst[i + k] = (T)prev;
+    }
+  }
+  return xdelta_decode(dst + i, n - i, p, end, (T)prev);
+}
+
+/**
+  xdelta 用于指定 xbin 以差值编码输入、输出整数数组。不输入元素个数。
+
+  \code
+    std::vector<uint32_t> ids;
+    bin << xlib::xdelta(ids);        // 差值 varint 编码。
+    bin << xlib::xdelta(ids, true);  // 按组位压缩。
+
+    std::vector<uint32_t> rs(n);
+    bin >> xlib::xdelta(rs);         // 按容器当前元素个数读取。
+  \endcode
+*/
+template <typename T>
+class xdelta {
+ public:
+  xdelta(T* const p, const size_t n, const bool packed = false)
+      : _p(p), _n(n), _packed(packed) {}
+  template <typename C>
+  xdelta(C& c, const bool packed = false)
+      : _p(c.data()), _n(c.size()), _packed(packed) {}
+  T* data() const { return _p; }
+  size_t size() const { return _n; }
+  bool packed() const { return _packed; }
+  /// 编码数据的最大长度。
+  size_t max_size() const { return _n * xvarint_max<T>; }
+  /// 编码，返回编码结尾。
+  uint8_t* encode(uint8_t* const p) const {
+    return _packed ? xdelta_pack(p, _p, _n) : xdelta_encode(p, _p, _n);
+  }
+  /// 解码，返回解码结尾。失败返回 nullptr 。
+  const uint8_t* decode(const uint8_t* const p, const uint8_t* const end) const {
+    return _packed ? xdelta_unpack(_p, _n, p, end)
+                   : xdelta_decode(_p, _n, p, end);
+  }
+
+ private:
+  T*      _p;
+  size_t  _n;
+  bool    _packed;
+};
+
+template <typename C>
+xdelta(C&, bool = false)
+    -> xdelta<std::remove_reference_t<decltype(*std::declval<C&>().data())>>;
+
 }  // namespace xlib
 
 #endif  // _XLIB_XVARINT_H_
\ No newline at end of file